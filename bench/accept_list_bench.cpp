@@ -0,0 +1,88 @@
+#include "headers/accept_list.hpp"
+#include "headers/media_type.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief `Accept` headers as sent by browsers and API clients.
+	constexpr std::array<std::string_view, 6> headers {
+		"text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7",
+		"text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8",
+		"application/json, text/plain, */*",
+		"application/vnd.github+json",
+		"*/*",
+		"image/avif,image/webp,image/apng,image/svg+xml,image/*,*/*;q=0.8",
+	};
+
+	void parse(benchmark::State& state)
+	{
+		std::int64_t size {};
+
+		for (const auto header : headers)
+		{
+			size += static_cast<std::int64_t>(header.size());
+		}
+
+		for (auto _ : state)
+		{
+			for (const auto header : headers)
+			{
+				benchmark::DoNotOptimize(accept_list::try_parse(header));
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * size);
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(headers.size()));
+	}
+
+	void negotiate(benchmark::State& state)
+	{
+		const std::vector<media_type> supported {"application/json", "application/xml", "text/html", "text/plain"};
+		std::vector<accept_list> lists {};
+
+		for (const auto header : headers)
+		{
+			lists.emplace_back(header);
+		}
+
+		for (auto _ : state)
+		{
+			for (const auto& list : lists)
+			{
+				benchmark::DoNotOptimize(common_good::negotiate(list, supported));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lists.size()));
+	}
+
+	/// @brief A header of `state.range(0)` distinct ranges with mixed weights, as a hostile client could send.
+	void parse_long(benchmark::State& state)
+	{
+		std::string header {};
+
+		for (std::int64_t index {}; index < state.range(0); ++index)
+		{
+			header += "type" + std::to_string(index) + "/sub;q=0." + std::to_string(index % 10) + ", ";
+		}
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(accept_list::try_parse(header));
+		}
+
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(header.size()));
+	}
+}
+
+BENCHMARK(parse)->Name("accept_list/try_parse");
+BENCHMARK(negotiate)->Name("accept_list/negotiate");
+BENCHMARK(parse_long)->Name("accept_list/try_parse/ranges")->RangeMultiplier(10)->Range(10, 10000);
@@ -0,0 +1,161 @@
+#include "content_types.hpp"
+#include "headers/ascii.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Every corpus value joined, so each iteration walks a few kilobytes of real header bytes.
+	auto corpus_bytes() -> const std::string&
+	{
+		static const auto bytes = []
+		{
+			std::string result {};
+
+			for (const auto type : corpus::content_types)
+			{
+				result.append(type).push_back('\n');
+			}
+
+			return result;
+		}();
+
+		return bytes;
+	}
+
+	template<auto Predicate>
+	void predicate(benchmark::State& state)
+	{
+		const auto& bytes = corpus_bytes();
+
+		for (auto _ : state)
+		{
+			std::size_t count {};
+
+			for (const auto character : bytes)
+			{
+				count += Predicate(character) ? 1 : 0;
+			}
+
+			benchmark::DoNotOptimize(count);
+		}
+
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes.size()));
+	}
+
+	template<auto Conversion>
+	void conversion(benchmark::State& state)
+	{
+		auto bytes = corpus_bytes();
+
+		for (auto _ : state)
+		{
+			for (auto& character : bytes)
+			{
+				character = Conversion(character);
+			}
+
+			benchmark::DoNotOptimize(bytes.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes.size()));
+	}
+
+	/// @brief Printable ascii bytes of the given length, so the validating kernels walk the whole string.
+	auto printable_bytes(const std::size_t length) -> std::string
+	{
+		std::string result(length, ' ');
+
+		for (std::size_t index {}; index < length; ++index)
+		{
+			result[index] = static_cast<char>('A' + index % 26 + (index % 3 == 0 ? 32 : 0));
+		}
+
+		return result;
+	}
+
+	/// @brief Bulk validation of `state.range(0)` bytes, through a kernel or one character at a time.
+	template<auto Validate>
+	void validate(benchmark::State& state)
+	{
+		const auto bytes = printable_bytes(static_cast<std::size_t>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Validate(bytes));
+		}
+
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+	}
+
+	/// @brief In-place conversion of `state.range(0)` bytes, through a kernel or one character at a time.
+	template<auto Convert>
+	void convert(benchmark::State& state)
+	{
+		auto bytes = printable_bytes(static_cast<std::size_t>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			Convert(bytes);
+			benchmark::DoNotOptimize(bytes.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+	}
+
+	/* What callers wrote before the kernels, one character through the class table at a time. */
+	auto all_ascii_bytewise(const std::string_view string) noexcept -> bool
+	{ return std::ranges::all_of(string, ascii::is_ascii); }
+
+	auto all_printable_bytewise(const std::string_view string) noexcept -> bool
+	{ return std::ranges::all_of(string, ascii::is_printable); }
+
+	void to_lowercase_bytewise(std::string& string) noexcept
+	{ std::ranges::transform(string, string.begin(), ascii::to_lowercase); }
+
+	void to_uppercase_bytewise(std::string& string) noexcept
+	{ std::ranges::transform(string, string.begin(), ascii::to_uppercase); }
+
+	void to_lowercase_kernel(std::string& string) noexcept { ascii::to_lowercase_in_place(string); }
+
+	void to_uppercase_kernel(std::string& string) noexcept { ascii::to_uppercase_in_place(string); }
+}
+
+BENCHMARK(predicate<ascii::is_ascii>)->Name("ascii/is_ascii");
+BENCHMARK(predicate<ascii::is_digit>)->Name("ascii/is_digit");
+BENCHMARK(predicate<ascii::is_alphabetic_lowercase>)->Name("ascii/is_alphabetic_lowercase");
+BENCHMARK(predicate<ascii::is_alphabetic_uppercase>)->Name("ascii/is_alphabetic_uppercase");
+BENCHMARK(predicate<ascii::is_alphanumeric_lowercase>)->Name("ascii/is_alphanumeric_lowercase");
+BENCHMARK(predicate<ascii::is_alphanumeric_uppercase>)->Name("ascii/is_alphanumeric_uppercase");
+BENCHMARK(predicate<ascii::is_alphabetic>)->Name("ascii/is_alphabetic");
+BENCHMARK(predicate<ascii::is_alphanumeric>)->Name("ascii/is_alphanumeric");
+BENCHMARK(predicate<ascii::is_hexadecimal>)->Name("ascii/is_hexadecimal");
+BENCHMARK(predicate<ascii::is_control>)->Name("ascii/is_control");
+BENCHMARK(predicate<ascii::is_printable>)->Name("ascii/is_printable");
+BENCHMARK(predicate<ascii::is_graphical>)->Name("ascii/is_graphical");
+BENCHMARK(predicate<ascii::is_blank>)->Name("ascii/is_blank");
+BENCHMARK(predicate<ascii::is_space>)->Name("ascii/is_space");
+BENCHMARK(predicate<ascii::is_whitespace>)->Name("ascii/is_whitespace");
+BENCHMARK(predicate<ascii::is_punctuation>)->Name("ascii/is_punctuation");
+BENCHMARK(conversion<ascii::to_lowercase>)->Name("ascii/to_lowercase");
+BENCHMARK(conversion<ascii::to_uppercase>)->Name("ascii/to_uppercase");
+
+
+/* 8 bytes to 1 MiB, by factors of 8. */
+BENCHMARK(validate<all_ascii_bytewise>)->Name("ascii/all_ascii/bytewise")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(validate<ascii::all_ascii>)->Name("ascii/all_ascii/kernel")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(validate<all_printable_bytewise>)->Name("ascii/all_printable/bytewise")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(validate<ascii::all_printable>)->Name("ascii/all_printable/kernel")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(convert<to_lowercase_bytewise>)->Name("ascii/to_lowercase_in_place/bytewise")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(convert<to_lowercase_kernel>)->Name("ascii/to_lowercase_in_place/kernel")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(convert<to_uppercase_bytewise>)->Name("ascii/to_uppercase_in_place/bytewise")->RangeMultiplier(8)->Range(8, 1 << 20);
+BENCHMARK(convert<to_uppercase_kernel>)->Name("ascii/to_uppercase_in_place/kernel")->RangeMultiplier(8)->Range(8, 1 << 20);
@@ -0,0 +1,292 @@
+#include "baseline_media_type.hpp"
+#include "content_types.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	template<typename Corpus>
+	auto total_size(const Corpus& corpus) -> std::int64_t
+	{
+		std::int64_t size {};
+
+		for (const auto type : corpus)
+		{
+			size += static_cast<std::int64_t>(type.size());
+		}
+
+		return size;
+	}
+
+	template<typename Corpus>
+	auto owned(const Corpus& corpus) -> std::vector<std::string>
+	{ return {corpus.begin(), corpus.end()}; }
+
+	/// @brief Construct from a string moved in, a copy made outside the timed region being moved on every iteration.
+	template<const auto& Corpus>
+	void construct_rvalue(benchmark::State& state)
+	{
+		const auto strings = owned(Corpus);
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto copies = strings;
+			state.ResumeTiming();
+
+			for (auto& string : copies)
+			{
+				try
+				{
+					benchmark::DoNotOptimize(media_type {std::move(string)});
+				}
+				catch (const media_type::parsing_error&)
+				{
+				}
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * total_size(Corpus));
+	}
+
+	/// @brief Construct from any of the copying sources, `const std::string&`, `std::string_view` or `const char*`.
+	template<const auto& Corpus, typename Source>
+	void construct(benchmark::State& state)
+	{
+		const auto strings = owned(Corpus);
+		std::vector<Source> sources {};
+
+		for (const auto& string : strings)
+		{
+			if constexpr (std::is_same_v<Source, const char*>)
+			{
+				sources.push_back(string.c_str());
+			}
+			else
+			{
+				sources.push_back(Source {string});
+			}
+		}
+
+		for (auto _ : state)
+		{
+			for (const auto& source : sources)
+			{
+				try
+				{
+					if constexpr (std::is_same_v<Source, std::reference_wrapper<const std::string>>)
+					{
+						benchmark::DoNotOptimize(media_type {source.get()});
+					}
+					else
+					{
+						benchmark::DoNotOptimize(media_type {source});
+					}
+				}
+				catch (const media_type::parsing_error&)
+				{
+				}
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * total_size(Corpus));
+	}
+
+	/// @brief Corpus values without parameters, as the baseline ignores them and would otherwise do less work.
+	auto without_parameters() -> std::vector<std::string>
+	{
+		std::vector<std::string> result {};
+
+		for (const auto type : corpus::content_types)
+		{
+			result.emplace_back(type.substr(0, type.find(';')));
+		}
+
+		return result;
+	}
+
+	/// @brief Parse throughput in bytes, the old multi-scan `prepare()` and `parse()` against the single-pass scanner.
+	template<typename Parse>
+	void parse(benchmark::State& state, Parse parse)
+	{
+		const auto strings = without_parameters();
+		std::int64_t size {};
+
+		for (const auto& string : strings)
+		{
+			size += static_cast<std::int64_t>(string.size());
+		}
+
+		for (auto _ : state)
+		{
+			for (const auto& string : strings)
+			{
+				benchmark::DoNotOptimize(parse(string));
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * size);
+	}
+
+	/// @brief Malformed corpus values that the baseline also rejects, as it ignores everything after ';'.
+	auto rejected_by_both() -> std::vector<std::string>
+	{
+		std::vector<std::string> result {};
+
+		for (const auto type : corpus::malformed_content_types)
+		{
+			try
+			{
+				static_cast<void>(baseline::media_type {type});
+			}
+			catch (const baseline::media_type::parsing_error&)
+			{
+				result.emplace_back(type);
+			}
+		}
+
+		return result;
+	}
+
+	/// @brief Rejection through a throwing constructor, `baseline::media_type` or `media_type`.
+	template<typename Type>
+	void reject_throwing(benchmark::State& state)
+	{
+		const auto strings = rejected_by_both();
+
+		for (auto _ : state)
+		{
+			for (const auto& string : strings)
+			{
+				try
+				{
+					benchmark::DoNotOptimize(Type {std::string_view {string}});
+				}
+				catch (const typename Type::parsing_error& error)
+				{
+					benchmark::DoNotOptimize(error.what());
+				}
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(strings.size()));
+	}
+
+	void reject_try_parse(benchmark::State& state)
+	{
+		const auto strings = rejected_by_both();
+
+		for (auto _ : state)
+		{
+			for (const auto& string : strings)
+			{
+				benchmark::DoNotOptimize(media_type::try_parse(string));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(strings.size()));
+	}
+
+	auto parsed_corpus() -> std::vector<media_type>
+	{ return {corpus::content_types.begin(), corpus::content_types.end()}; }
+
+	template<auto Accessor>
+	void accessor(benchmark::State& state)
+	{
+		const auto types = parsed_corpus();
+
+		for (auto _ : state)
+		{
+			for (const auto& type : types)
+			{
+				benchmark::DoNotOptimize(Accessor(type));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(types.size()));
+	}
+
+	void format(benchmark::State& state)
+	{
+		const auto types = parsed_corpus();
+
+		for (auto _ : state)
+		{
+			for (const auto& type : types)
+			{
+				benchmark::DoNotOptimize(std::format("{}", type));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(types.size()));
+	}
+
+	/// @brief Response header line appended to a buffer reserved once, as the response writers do.
+	template<typename Type>
+	void format_to(benchmark::State& state)
+	{
+		const Type type {"application/vnd.api+json; Charset=UTF-8"};
+		std::string buffer {};
+		buffer.reserve(256);
+
+		for (auto _ : state)
+		{
+			buffer.clear();
+			std::format_to(std::back_inserter(buffer), "Content-Type: {:w}\r\n", type);
+			benchmark::DoNotOptimize(buffer.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * buffer.size()));
+	}
+
+	constexpr auto string = [](const media_type& type) { return type.string().size(); };
+	constexpr auto type = [](const media_type& type) { return type.type(); };
+	constexpr auto tree = [](const media_type& type) { return type.tree(); };
+	constexpr auto subtype = [](const media_type& type) { return type.subtype(); };
+	constexpr auto suffix = [](const media_type& type) { return type.suffix(); };
+	constexpr auto in_standards_tree = [](const media_type& type) { return type.in_standards_tree(); };
+	constexpr auto equality = [](const media_type& type) { return type == "application/json"; };
+
+	using reference = std::reference_wrapper<const std::string>;
+}
+
+BENCHMARK(construct_rvalue<corpus::content_types>)->Name("media_type/construct/string&&/valid");
+BENCHMARK(construct<corpus::content_types, reference>)->Name("media_type/construct/const string&/valid");
+BENCHMARK(construct<corpus::content_types, std::string_view>)->Name("media_type/construct/string_view/valid");
+BENCHMARK(construct<corpus::content_types, const char*>)->Name("media_type/construct/const char*/valid");
+BENCHMARK(construct_rvalue<corpus::malformed_content_types>)->Name("media_type/construct/string&&/rejected");
+BENCHMARK(construct<corpus::malformed_content_types, reference>)->Name("media_type/construct/const string&/rejected");
+BENCHMARK(construct<corpus::malformed_content_types, std::string_view>)->Name("media_type/construct/string_view/rejected");
+BENCHMARK(construct<corpus::malformed_content_types, const char*>)->Name("media_type/construct/const char*/rejected");
+
+BENCHMARK_CAPTURE(parse, before, [](const std::string& type) { return baseline::media_type {std::string_view {type}}; })
+	->Name("media_type/parse/before");
+BENCHMARK_CAPTURE(parse, after, [](const std::string& type) { return media_type::try_parse(type); })->Name("media_type/parse/after");
+
+BENCHMARK(reject_throwing<baseline::media_type>)->Name("media_type/reject/before/constructor");
+BENCHMARK(reject_throwing<media_type>)->Name("media_type/reject/after/constructor");
+BENCHMARK(reject_try_parse)->Name("media_type/reject/after/try_parse");
+
+BENCHMARK(accessor<string>)->Name("media_type/string");
+BENCHMARK(accessor<type>)->Name("media_type/type");
+BENCHMARK(accessor<tree>)->Name("media_type/tree");
+BENCHMARK(accessor<subtype>)->Name("media_type/subtype");
+BENCHMARK(accessor<suffix>)->Name("media_type/suffix");
+BENCHMARK(accessor<in_standards_tree>)->Name("media_type/in_standards_tree");
+BENCHMARK(accessor<equality>)->Name("media_type/operator==");
+BENCHMARK(format)->Name("media_type/std::format");
+BENCHMARK(format_to<media_type>)->Name("media_type/std::format_to/back_inserter/media_type");
+BENCHMARK(format_to<media_type_view>)->Name("media_type/std::format_to/back_inserter/media_type_view");
@@ -0,0 +1,185 @@
+#include "baseline_media_type.hpp"
+#include "headers/compact_media_type.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_parser.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__x86_64__) or defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+/*
+	Differential oracle for every parser of the tree over arbitrary bytes, as a libFuzzer target.
+	Also linked into `common_good_fuzz_replay` with a driver of its own, so compilers without libFuzzer still run it.
+
+	COMMON_GOOD_FUZZ_CYCLES_PER_BYTE sets the parse cost above which an input is reported as a slow path, 4000 by default.
+*/
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Stop the run on a disagreement, so the fuzzer keeps the input that caused it.
+	[[noreturn]] void disagree(const std::string_view input, const char* const what)
+	{
+		std::fprintf(stderr, "disagreement: %s\ninput (%zu bytes): \"", what, input.size());
+
+		for (const auto character : input)
+		{
+			std::fprintf(stderr, ascii::is_printable(character) ? "%c" : "\\x%02X", static_cast<unsigned char>(character));
+		}
+
+		std::fprintf(stderr, "\"\n");
+		std::abort();
+	}
+
+	void expect(const bool condition, const std::string_view input, const char* const what)
+	{
+		if (not condition)
+		{
+			disagree(input, what);
+		}
+	}
+
+	[[nodiscard]] auto ticks() noexcept -> std::uint64_t
+	{
+#if defined(__x86_64__) or defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	[[nodiscard]] auto cycles_per_byte_limit() noexcept -> std::uint64_t
+	{
+		static const auto limit = []() -> std::uint64_t
+		{
+			if (const auto* const value = std::getenv("COMMON_GOOD_FUZZ_CYCLES_PER_BYTE"))
+			{
+				return std::strtoull(value, nullptr, 10);
+			}
+
+			return 4000;
+		}();
+
+		return limit;
+	}
+
+	/// @brief Least cost of a few parses, so a single preemption is not taken for a slow path.
+	void expect_linear_cost(const std::string_view input)
+	{
+		/* Short inputs are dominated by fixed costs and timer resolution. */
+		if (input.size() < 64)
+		{
+			return;
+		}
+
+		auto least = ~std::uint64_t {};
+
+		for (int round {}; round < 3; ++round)
+		{
+			const auto start = ticks();
+			static_cast<void>(media_type::try_parse(input));
+			least = std::min(least, ticks() - start);
+		}
+
+		if (const auto per_byte = least / input.size(); per_byte > cycles_per_byte_limit())
+		{
+			std::fprintf(stderr, "slow path: %llu cycles per byte\n", static_cast<unsigned long long>(per_byte));
+			disagree(input, "parse cost above COMMON_GOOD_FUZZ_CYCLES_PER_BYTE");
+		}
+	}
+
+	/// @brief Reason of the throwing constructor, to compare with `try_parse`.
+	[[nodiscard]] auto constructor_error(const std::string_view input) -> std::optional<media_type::error>
+	{
+		try
+		{
+			static_cast<void>(media_type {input});
+			return std::nullopt;
+		}
+		catch (const media_type::parsing_error& error)
+		{
+			return error.code();
+		}
+	}
+
+	/// @brief Incremental parse, split once at an offset taken from the input so every split point is reached.
+	[[nodiscard]] auto incremental(const std::string_view input) -> std::expected<media_type, media_type::error>
+	{
+		media_type_parser parser {};
+		const auto split = input.empty() ? 0 : static_cast<unsigned char>(input.front()) % (input.size() + 1);
+
+		parser.feed(input.substr(0, split));
+		parser.feed(input.substr(split));
+		return std::move(parser).finish();
+	}
+
+	void check(const std::string_view input)
+	{
+		const auto owning = media_type::try_parse(input);
+		const auto view = media_type_view::try_parse(input);
+		const auto constructed = constructor_error(input);
+		const auto chunked = incremental(input);
+
+		expect(owning.has_value() == view.has_value(), input, "try_parse against media_type_view::try_parse");
+		expect(owning.has_value() == not constructed, input, "try_parse against the throwing constructor");
+		expect(owning.has_value() == chunked.has_value(), input, "try_parse against media_type_parser");
+
+		if (owning)
+		{
+			expect(*view == *owning, input, "media_type_view against media_type");
+			expect(view->tree().size() == owning->tree().size() and view->suffix().size() == owning->suffix().size(), input,
+				   "offsets of media_type_view against media_type");
+			expect(*chunked == *owning and chunked->parameters_string() == owning->parameters_string(), input,
+				   "media_type_parser against media_type");
+			expect(compact_media_type {*owning} == *owning, input, "compact_media_type against media_type");
+		}
+		else
+		{
+			expect(view.error() == owning.error(), input, "error of media_type_view::try_parse");
+			expect(*constructed == owning.error(), input, "error of the throwing constructor");
+			expect(chunked.error() == owning.error(), input, "error of media_type_parser");
+		}
+
+		/* The baseline drops parameters unvalidated, so it is only an oracle for input without them. */
+		if (input.find(';') == std::string_view::npos)
+		{
+			try
+			{
+				const baseline::media_type expected {input};
+
+				expect(owning.has_value(), input, "rejected, baseline accepts");
+				expect(owning->string() == expected.string(), input, "string against baseline");
+				expect(owning->type() == expected.type() and owning->tree() == expected.tree() and owning->subtype() == expected.subtype()
+						   and owning->suffix() == expected.suffix(),
+					   input, "offsets against baseline");
+			}
+			catch (const baseline::media_type::parsing_error& error)
+			{
+				expect(not owning.has_value(), input, "accepted, baseline rejects");
+				expect(std::string_view {media_type::message(owning.error())} == error.what(), input, "error against baseline");
+			}
+		}
+
+		expect_linear_cost(input);
+	}
+}
+
+extern "C" auto LLVMFuzzerTestOneInput(const std::uint8_t* const data, const std::size_t size) -> int
+{
+	check({reinterpret_cast<const char*>(data), size});
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include "content_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+
+/*
+	Driver for compilers without libFuzzer. Replays the files or directories given, such as a corpus or a crash kept by
+	libFuzzer, or without arguments the Content-Type corpus and a fixed number of random edits of it.
+*/
+
+extern "C" auto LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) -> int;
+
+namespace
+{
+	void run(const std::string_view input)
+	{ LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size()); }
+
+	void replay(const std::filesystem::path& path)
+	{
+		std::ifstream file {path, std::ios::binary};
+		const std::string input {std::istreambuf_iterator<char> {file}, {}};
+
+		run(input);
+	}
+
+	/// @brief Random edits of the corpus, biased towards the characters the grammar gives a meaning to.
+	void mutate(const std::size_t rounds)
+	{
+		constexpr std::string_view alphabet {"aZ09/.+-!#$&^_ \t;=\"\\%*,\x80\xFF"};
+		std::mt19937 generator {2045};
+
+		for (std::size_t round {}; round < rounds; ++round)
+		{
+			std::span<const std::string_view> values {common_good::corpus::content_types};
+
+			if (generator() % 4 == 0)
+			{
+				values = common_good::corpus::malformed_content_types;
+			}
+
+			std::string input {values[generator() % values.size()]};
+
+			for (auto edits = generator() % 5; edits; --edits)
+			{
+				const auto position = generator() % (input.size() + 1);
+				const auto character = alphabet[generator() % alphabet.size()];
+
+				if (const auto edit = generator() % 4; edit == 0 or position == input.size())
+				{
+					input.insert(position, 1, character);
+				}
+				else if (edit == 1)
+				{
+					input[position] = character;
+				}
+				else if (edit == 2)
+				{
+					input.erase(position, 1);
+				}
+				else
+				{
+					input.insert(position, input.substr(position, generator() % 64));
+				}
+			}
+
+			run(input);
+		}
+	}
+}
+
+auto main(const int count, char** const arguments) -> int
+{
+	if (count > 1)
+	{
+		for (int index {1}; index < count; ++index)
+		{
+			if (const std::filesystem::path path {arguments[index]}; std::filesystem::is_directory(path))
+			{
+				for (const auto& entry : std::filesystem::recursive_directory_iterator {path})
+				{
+					if (entry.is_regular_file())
+					{
+						replay(entry.path());
+					}
+				}
+			}
+			else
+			{
+				replay(path);
+			}
+		}
+	}
+	else
+	{
+		for (const auto type : common_good::corpus::content_types)
+		{
+			run(type);
+		}
+
+		for (const auto type : common_good::corpus::malformed_content_types)
+		{
+			run(type);
+		}
+
+		mutate(200000);
+	}
+
+	std::puts("no disagreements");
+	return 0;
+}
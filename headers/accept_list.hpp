@@ -0,0 +1,430 @@
+#pragma once
+
+/*
+	https://datatracker.ietf.org/doc/html/rfc9110#section-12.5.1
+	https://datatracker.ietf.org/doc/html/rfc9110#section-12.4.2 (qvalue)
+*/
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+#include "small_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Media ranges of an `Accept` header as defined by RFC 9110, parsed into views of the header sorted by weight.
+	/// @brief Ranges of equal weight are ordered most specific first, otherwise as written. The header must outlive the list.
+	class accept_list
+	{
+	  public:
+		/// @brief Media range 'type/subtype', 'type/*' or '*/*' with optional parameters and weight, viewing into the header.
+		class range
+		{
+			/// @brief Top-level type, or '*' if any.
+			std::string_view type_text;
+
+			/// @brief Subtype including tree and suffix, or '*' if any.
+			std::string_view subtype_text;
+
+			/// @brief Media type parameters before the weight, as written.
+			std::string_view parameter_text;
+
+			std::uint16_t weight_value {1000};
+
+			friend class accept_list;
+
+		  public:
+			[[nodiscard]] constexpr range() noexcept = default;
+
+			/// @brief Get top-level type in original casing, or '*' if any.
+			[[nodiscard]] constexpr auto type() const noexcept -> std::string_view { return type_text; }
+
+			/// @brief Get subtype including tree and suffix in original casing, or '*' if any.
+			[[nodiscard]] constexpr auto subtype() const noexcept -> std::string_view { return subtype_text; }
+
+			/// @brief Get media type parameters as written, weight and any extension parameters after it not included.
+			[[nodiscard]] constexpr auto parameters_string() const noexcept -> std::string_view { return parameter_text; }
+
+			/// @brief Get weight in thousandths, that is 'q=0.5' is 500. Ranges without weight have 1000.
+			[[nodiscard]] constexpr auto weight() const noexcept -> std::uint16_t { return weight_value; }
+
+			/// @brief Get precedence among ranges matching the same type: '*/*' is 0, 'type/*' is 1, 'type/subtype' is 2, and 3 with
+			/// parameters.
+			[[nodiscard]] constexpr auto specificity() const noexcept -> unsigned
+			{
+				if (type_text == "*")
+				{
+					return 0;
+				}
+				else if (subtype_text == "*")
+				{
+					return 1;
+				}
+				else
+				{
+					return parameter_text.empty() ? 2 : 3;
+				}
+			}
+
+			/// @brief Check if media type is within range. Every parameter of the range must be present in the media type with an equal
+			/// value, names compared case-insensitively and values as written.
+			/// @param type Media type to test.
+			/// @return True if media type is within range.
+			[[nodiscard]] constexpr auto matches(const media_type_view type) const noexcept -> bool
+			{
+				if (type_text != "*" and not media_type::equals_ignore_case(type_text, type.type()))
+				{
+					return false;
+				}
+
+				if (subtype_text != "*" and not media_type::equals_ignore_case(subtype_text, type.string().substr(type.type().size() + 1)))
+				{
+					return false;
+				}
+
+				bool matched {true};
+
+				auto visitor = [&](const std::string_view name, const std::string_view value, bool) noexcept
+				{
+					const auto other = type.parameter(name);
+					matched = other and *other == value;
+					return matched;
+				};
+
+				static_cast<void>(media_type::parse_parameters(parameter_text, visitor));
+				return matched;
+			}
+		};
+
+		using value_type = range;
+		using const_iterator = const range*;
+
+	  private:
+		/// @brief Eight ranges are stored without allocation, which covers the headers sent by browsers and most API clients.
+		small_vector<range, 8> ranges;
+
+		[[nodiscard]] constexpr static auto trim_blanks(std::string_view text) noexcept -> std::string_view
+		{
+			while (not text.empty() and ascii::is_blank(text.front()))
+			{
+				text.remove_prefix(1);
+			}
+
+			while (not text.empty() and ascii::is_blank(text.back()))
+			{
+				text.remove_suffix(1);
+			}
+
+			return text;
+		}
+
+		/// @brief Parse qvalue, '0' or '1' optionally followed by '.' and at most three digits, and not above 1.
+		/// @param value Parameter value.
+		/// @return Weight in thousandths, or nothing if value is not a qvalue.
+		[[nodiscard]] constexpr static auto parse_weight(const std::string_view value) noexcept -> std::optional<std::uint16_t>
+		{
+			if (value.empty() or value.size() > 5 or (value[0] != '0' and value[0] != '1') or (value.size() > 1 and value[1] != '.'))
+			{
+				return std::nullopt;
+			}
+
+			unsigned weight = value[0] == '1' ? 1000 : 0;
+			unsigned scale {100};
+
+			for (std::size_t index {2}; index < value.size(); ++index, scale /= 10)
+			{
+				if (not ascii::is_digit(value[index]))
+				{
+					return std::nullopt;
+				}
+
+				weight += static_cast<unsigned>(value[index] - '0') * scale;
+			}
+
+			if (weight > 1000)
+			{
+				return std::nullopt;
+			}
+
+			return static_cast<std::uint16_t>(weight);
+		}
+
+		/// @brief Validate top-level type of a 'type/*' range, with the same rules and errors as a media type.
+		[[nodiscard]] constexpr static auto validate_type(const std::string_view type) noexcept -> std::expected<void, media_type::error>
+		{
+			if (type.empty() or type.size() > 127)
+			{
+				return std::unexpected {media_type::error::type_length};
+			}
+
+			if (not ascii::is_alphanumeric(type.front()))
+			{
+				return std::unexpected {media_type::error::type_first_character};
+			}
+
+			if (not ascii::all_of(type, ascii::character_class::restricted_name))
+			{
+				return std::unexpected {media_type::error::type_character};
+			}
+
+			return {};
+		}
+
+		/// @brief Parse a single list element and append it, `sort()` orders the list once all are added.
+		/// @param element Text between two ',', or the ends of the header.
+		/// @return Nothing, or the first validation error encountered.
+		[[nodiscard]] constexpr auto add(std::string_view element) -> std::expected<void, media_type::error>
+		{
+			element = trim_blanks(element);
+
+			/* Empty list elements are allowed, as in 'text/html,,text/plain'. */
+			if (element.empty())
+			{
+				return {};
+			}
+
+			const auto semicolon = element.find(';');
+			const auto text = trim_blanks(element.substr(0, semicolon));
+			const auto slash = text.find('/');
+
+			range entry {};
+
+			if (text == "*/*")
+			{
+				entry.type_text = text.substr(0, 1);
+				entry.subtype_text = text.substr(2);
+			}
+			else if (slash != std::string_view::npos and text.substr(slash + 1) == "*")
+			{
+				if (const auto result = validate_type(text.substr(0, slash)); not result)
+				{
+					return result;
+				}
+
+				entry.type_text = text.substr(0, slash);
+				entry.subtype_text = text.substr(slash + 1);
+			}
+			else if (const auto type = media_type_view::try_parse(text); type)
+			{
+				entry.type_text = type->type();
+				entry.subtype_text = text.substr(slash + 1);
+			}
+			else
+			{
+				return std::unexpected {type.error()};
+			}
+
+			if (semicolon != std::string_view::npos)
+			{
+				const auto parameters = element.substr(semicolon + 1);
+				bool weighted {};
+				bool valid {true};
+
+				/* The first 'q' ends the media type parameters, anything after it is an extension parameter. */
+				auto visitor = [&](const std::string_view name, const std::string_view value, const bool quoted) noexcept
+				{
+					if (not weighted and media_type::equals_ignore_case(name, "q"))
+					{
+						weighted = true;
+						entry.parameter_text = parameters.substr(0, static_cast<std::size_t>(name.data() - parameters.data()));
+
+						if (const auto weight = parse_weight(value); weight and not quoted)
+						{
+							entry.weight_value = *weight;
+						}
+						else
+						{
+							valid = false;
+						}
+					}
+
+					return valid;
+				};
+
+				if (const auto result = media_type::parse_parameters(parameters, visitor); not result)
+				{
+					return result;
+				}
+
+				if (not valid)
+				{
+					return std::unexpected {media_type::error::parameter_weight};
+				}
+
+				if (not weighted)
+				{
+					entry.parameter_text = parameters;
+				}
+
+				while (not entry.parameter_text.empty() and (entry.parameter_text.back() == ';' or ascii::is_blank(entry.parameter_text.back())))
+				{
+					entry.parameter_text.remove_suffix(1);
+				}
+
+				entry.parameter_text = trim_blanks(entry.parameter_text);
+			}
+
+			ranges.push_back(entry);
+			return {};
+		}
+
+		/// @brief Order ranges by weight, then by specificity, keeping header order among equals.
+		/// @brief Runs once after every range is parsed, as the number of ranges is chosen by the client.
+		constexpr void sort()
+		{
+			if consteval
+			{
+				/* `std::ranges::stable_sort` is not constexpr before C++26, and headers known at compile time are short. */
+				for (std::size_t sorted {1}; sorted < ranges.size(); ++sorted)
+				{
+					for (auto index = sorted; index != 0 and precedes(ranges[index], ranges[index - 1]); --index)
+					{
+						std::swap(ranges[index], ranges[index - 1]);
+					}
+				}
+			}
+			else
+			{
+				std::ranges::stable_sort(ranges, precedes);
+			}
+		}
+
+		[[nodiscard]] constexpr static auto precedes(const range& left, const range& right) noexcept -> bool
+		{
+			return left.weight_value > right.weight_value
+				   or (left.weight_value == right.weight_value and left.specificity() > right.specificity());
+		}
+
+	  public:
+		/// @brief Empty list, as for a request without `Accept` header, accepting any media type.
+		[[nodiscard]] constexpr accept_list() noexcept = default;
+
+		/// @brief Media ranges as defined by RFC 9110.
+		/// @param header Value of `Accept` header in format 'type/subtype;name=value;q=0.5, type/*', must outlive the list.
+		/// @exception media_type::parsing_error If header fail to parse.
+		[[nodiscard]] constexpr accept_list(const std::string_view header)
+		{
+			if (auto result = try_parse(header); result)
+			{
+				*this = std::move(*result);
+			}
+			else
+			{
+				throw media_type::parsing_error {result.error()};
+			}
+		}
+
+		/// @brief Media ranges as defined by RFC 9110.
+		/// @param header Null-terminated value of `Accept` header in format 'type/subtype;name=value;q=0.5, type/*', must outlive the list.
+		/// @exception media_type::parsing_error If header fail to parse.
+		[[nodiscard]] constexpr accept_list(const char* const header) : accept_list {std::string_view {header}} { }
+
+		/// @brief Media ranges as defined by RFC 9110.
+		/// @param header Value of `Accept` header in format 'type/subtype;name=value;q=0.5, type/*', must outlive the list.
+		/// @exception media_type::parsing_error If header fail to parse.
+		[[nodiscard]] constexpr accept_list(const std::string& header) : accept_list {std::string_view {header}} { }
+
+		/// @brief Viewing a temporary string would dangle.
+		accept_list(std::string&&) = delete;
+
+		/// @brief Non-throwing alternative to the constructors, for headers that are expected to be malformed now and then.
+		/// @param header Value of `Accept` header in format 'type/subtype;name=value;q=0.5, type/*', must outlive the list.
+		/// @return Media ranges, or the reason the header fail to parse.
+		[[nodiscard]] constexpr static auto try_parse(const std::string_view header) -> std::expected<accept_list, media_type::error>
+		{
+			accept_list list {};
+			std::size_t index {};
+
+			while (index < header.size())
+			{
+				const auto start = index;
+				bool quoted {};
+
+				/* Split at ',' outside of quoted-string, a quoted-pair may escape '"'. */
+				for (; index < header.size() and (quoted or header[index] != ','); ++index)
+				{
+					if (quoted and header[index] == '\\' and index + 1 < header.size())
+					{
+						++index;
+					}
+					else if (header[index] == '"')
+					{
+						quoted = not quoted;
+					}
+				}
+
+				if (const auto result = list.add(header.substr(start, index - start)); not result)
+				{
+					return std::unexpected {result.error()};
+				}
+
+				++index;
+			}
+
+			list.sort();
+			return list;
+		}
+
+		/// @brief Get weight of media type, that of the most specific matching range.
+		/// @param type Media type to weigh.
+		/// @return Weight in thousandths, 0 if not acceptable. An empty list accepts anything with weight 1000.
+		[[nodiscard]] constexpr auto weight(const media_type_view type) const noexcept -> std::uint16_t
+		{
+			if (ranges.empty())
+			{
+				return 1000;
+			}
+
+			const range* best {};
+
+			/* Ranges are sorted by weight, so the first of equal specificity is also the heaviest. */
+			for (const auto& range : ranges)
+			{
+				if ((not best or range.specificity() > best->specificity()) and range.matches(type))
+				{
+					best = &range;
+				}
+			}
+
+			return best ? best->weight_value : 0;
+		}
+
+		[[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return ranges.begin(); }
+		[[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return ranges.end(); }
+		[[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return ranges.size(); }
+		[[nodiscard]] constexpr auto empty() const noexcept -> bool { return ranges.empty(); }
+		[[nodiscard]] constexpr auto operator[](const std::size_t index) const noexcept -> const range& { return ranges[index]; }
+	};
+
+	/// @brief Choose the supported media type with the highest weight. Does not allocate.
+	/// @param accept Parsed `Accept` header.
+	/// @param supported Media types the server can produce, most preferred first which decides between equal weights.
+	/// @return View of the chosen element of `supported`, or nothing if none is acceptable.
+	[[nodiscard]] constexpr auto negotiate(const accept_list& accept, const std::span<const media_type> supported) noexcept
+		-> std::optional<media_type_view>
+	{
+		std::optional<media_type_view> best {};
+		std::uint16_t best_weight {};
+
+		for (const auto& type : supported)
+		{
+			if (const auto weight = accept.weight(type); weight > best_weight)
+			{
+				best = media_type_view {type};
+				best_weight = weight;
+			}
+		}
+
+		return best;
+	}
+}
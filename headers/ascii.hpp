@@ -1,41 +1,139 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#if defined(__SSE2__) or defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
 namespace common_good::ascii
 {
+	/// @brief Bitmask of character classes, see `character_class`.
+	using class_mask = std::uint16_t;
+
+	/// @brief Character classes, combine with '|' to test several classes with a single `matches` lookup.
+	namespace character_class
+	{
+		static constexpr class_mask digit = 1 << 0;
+		static constexpr class_mask alphabetic_lowercase = 1 << 1;
+		static constexpr class_mask alphabetic_uppercase = 1 << 2;
+		static constexpr class_mask hexadecimal = 1 << 3;
+		static constexpr class_mask space = 1 << 4;
+		static constexpr class_mask blank = 1 << 5;
+		static constexpr class_mask punctuation = 1 << 6;
+		static constexpr class_mask control = 1 << 7;
+		static constexpr class_mask printable = 1 << 8;
+		static constexpr class_mask graphical = 1 << 9;
+
+		/// @brief RFC 6838 restricted-name-chars, alphanumeric or '!', '#', '$', '&', '-', '^', '_', '.', '+'.
+		static constexpr class_mask restricted_name = 1 << 10;
+
+		/// @brief RFC 6838 restricted-name-chars without '.' and '+', alphanumeric or '!', '#', '$', '&', '-', '^', '_'.
+		static constexpr class_mask modified_restricted_name = 1 << 11;
+
+		/// @brief RFC 9110 tchar, alphanumeric or '!', '#', '$', '%', '&', ''', '*', '+', '-', '.', '^', '_', '`', '|', '~'.
+		static constexpr class_mask token = 1 << 12;
+
+		/// @brief WHATWG ascii whitespace, space, form feed, new line, carriage return or horizontal tabulation but not vertical tabulation.
+		static constexpr class_mask whitespace = 1 << 13;
+
+		static constexpr class_mask alphabetic = alphabetic_lowercase | alphabetic_uppercase;
+		static constexpr class_mask alphanumeric = alphabetic | digit;
+		static constexpr class_mask alphanumeric_lowercase = alphabetic_lowercase | digit;
+		static constexpr class_mask alphanumeric_uppercase = alphabetic_uppercase | digit;
+
+		/// @brief Classes of every byte value, non-ascii bytes belong to no class.
+		static constexpr auto table = []
+		{
+			std::array<class_mask, 256> table {};
+
+			for (unsigned index = 0; index < 128; ++index)
+			{
+				const auto character = static_cast<char>(index);
+				auto& mask = table[index];
+
+				auto in = [character](const char first, const char last) noexcept { return character >= first and character <= last; };
+
+				mask |= in('0', '9') ? digit : 0;
+				mask |= in('a', 'z') ? alphabetic_lowercase : 0;
+				mask |= in('A', 'Z') ? alphabetic_uppercase : 0;
+				mask |= in('0', '9') or in('a', 'f') or in('A', 'F') ? hexadecimal : 0;
+				mask |= in(char {9}, char {13}) or character == ' ' ? space : 0;
+				mask |= character == ' ' or character == '\t' ? blank : 0;
+				mask |= (in(char {9}, char {13}) and character != char {11}) or character == ' ' ? whitespace : 0;
+				mask |= in(char {33}, char {47}) or in(char {58}, char {64}) or in(char {91}, char {96}) or in(char {123}, char {126})
+							? punctuation
+							: 0;
+				mask |= in(char {0}, char {31}) or character == char {127} ? control : 0;
+				mask |= in(char {32}, char {126}) ? printable : 0;
+				mask |= in(char {33}, char {126}) ? graphical : 0;
+
+				if (in('0', '9') or in('a', 'z') or in('A', 'Z') or std::string_view {"!#$&-^_"}.contains(character))
+				{
+					mask |= modified_restricted_name | restricted_name;
+				}
+
+				mask |= character == '.' or character == '+' ? restricted_name : 0;
+
+				if (in('0', '9') or in('a', 'z') or in('A', 'Z') or std::string_view {"!#$%&'*+-.^_`|~"}.contains(character))
+				{
+					mask |= token;
+				}
+			}
+
+			return table;
+		}();
+	}
+
+	/// @brief Test if character belong to any of the classes in mask, using a single table lookup.
+	/// @param character Character to test.
+	/// @param mask Classes from `character_class`, combined with '|'.
+	/// @return True if character match.
+	[[nodiscard]] constexpr auto matches(const char character, const class_mask mask) noexcept -> bool
+	{ return (character_class::table[static_cast<unsigned char>(character)] & mask) != 0; }
+
 	/// @brief Test if character is ascii [0..127].
 	/// @param character Character to test.
 	/// @return True if character is ascii.
 	[[nodiscard]] constexpr auto is_ascii(const char character) noexcept -> bool
-	{ return character == char {0} or (character > char {0} and character <= char {127}); }
+	{ return (static_cast<unsigned char>(character) & 0x80) == 0; }
 
 	/// @brief Test if character is digit [0-9].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
-	[[nodiscard]] constexpr auto is_digit(const char character) noexcept -> bool { return character >= '0' and character <= '9'; }
+	[[nodiscard]] constexpr auto is_digit(const char character) noexcept -> bool { return matches(character, character_class::digit); }
 
 	/// @brief Test if character is alphabetic lowercase [a-z].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphabetic_lowercase(const char character) noexcept -> bool
-	{ return character >= 'a' and character <= 'z'; }
+	{ return matches(character, character_class::alphabetic_lowercase); }
 
 	/// @brief Test if character is alphabetic uppercase [A-Z].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphabetic_uppercase(const char character) noexcept -> bool
-	{ return character >= 'A' and character <= 'Z'; }
+	{ return matches(character, character_class::alphabetic_uppercase); }
 
 	/// @brief Test if character is alphabetic uppercase or digit [A-Z0-9].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphanumeric_uppercase(const char character) noexcept -> bool
-	{ return is_alphabetic_uppercase(character) or is_digit(character); }
+	{ return matches(character, character_class::alphanumeric_uppercase); }
 
 	/// @brief Test if character is alphabetic lowercase or digit [a-z0-9].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphanumeric_lowercase(const char character) noexcept -> bool
-	{ return is_alphabetic_lowercase(character) or is_digit(character); }
+	{ return matches(character, character_class::alphanumeric_lowercase); }
 
 	/// @brief Convert character to lowercase.
 	/// @param character Ascii character to convert.
@@ -56,57 +154,384 @@ namespace common_good::ascii
 	/// Delete.
 	/// @param character Ascii character to test.
 	/// @return True if character match.
-	[[nodiscard]] constexpr auto is_control(const char character) noexcept -> bool
-	{ return character == char {0} or (character > char {0} and character <= char {31}) or (character == char {127}); }
+	[[nodiscard]] constexpr auto is_control(const char character) noexcept -> bool { return matches(character, character_class::control); }
 
 	/// @brief Test if character is space, alphanumeric [a-zA-Z0-9], punctuation.
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_printable(const char character) noexcept -> bool
-	{ return character >= char {32} and character <= char {126}; }
+	{ return matches(character, character_class::printable); }
 
 	/// @brief Test if character is alphanumeric [a-zA-Z0-9], punctuation.
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_graphical(const char character) noexcept -> bool
-	{ return is_printable(character) and character != ' '; }
+	{ return matches(character, character_class::graphical); }
 
 	/// @brief Test if character is space or horizontal tabulation.
 	/// @param character Ascii character to test.
 	/// @return True if character match.
-	[[nodiscard]] constexpr auto is_blank(const char character) noexcept -> bool { return character == ' ' or character == '\t'; }
+	[[nodiscard]] constexpr auto is_blank(const char character) noexcept -> bool { return matches(character, character_class::blank); }
 
 	/// @brief Test if character is alphabetic [a-zA-Z].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphabetic(const char character) noexcept -> bool
-	{ return is_alphabetic_uppercase(character) or is_alphabetic_lowercase(character); }
+	{ return matches(character, character_class::alphabetic); }
 
 	/// @brief Test if character is alphabetic or digit [a-zA-Z0-9].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_alphanumeric(const char character) noexcept -> bool
-	{ return is_alphabetic(character) or is_digit(character); }
+	{ return matches(character, character_class::alphanumeric); }
 
 	/// @brief Test if character is hexadecimal digit [0-9a-fA-F].
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_hexadecimal(const char character) noexcept -> bool
-	{ return is_digit(character) or (character >= 'A' and character <= 'F') or (character >= 'a' and character <= 'f'); }
+	{ return matches(character, character_class::hexadecimal); }
 
 	/// @brief Test if character is space, form feed, new line, carriage return, horizontal tabulation or vertical tabulation.
 	/// @param character Ascii character to test.
 	/// @return True if character match.
-	[[nodiscard]] constexpr auto is_space(const char character) noexcept -> bool
-	{ return (character >= char {9} and character <= char {13}) or (character == ' '); }
+	[[nodiscard]] constexpr auto is_space(const char character) noexcept -> bool { return matches(character, character_class::space); }
+
+	/// @brief Test if character is space, form feed, new line, carriage return or horizontal tabulation.
+	/// @brief Same as `is_space(char)` but without vertical tabulation, as WHATWG defines ascii whitespace.
+	/// @param character Ascii character to test.
+	/// @return True if character match.
+	[[nodiscard]] constexpr auto is_whitespace(const char character) noexcept -> bool
+	{ return matches(character, character_class::whitespace); }
 
 	/// @brief Test if character is ! " # $ % & ' ( ) * + , - . / : ; < = > ? @ [ \ ] ^ _ ` { | } ~
 	/// @param character Ascii character to test.
 	/// @return True if character match.
 	[[nodiscard]] constexpr auto is_punctuation(const char character) noexcept -> bool
+	{ return matches(character, character_class::punctuation); }
+
+	/// @brief Test if all characters are ascii [0..127]. Vectorised where supported.
+	/// @param string Characters to test.
+	/// @return True if every character is ascii, also when string is empty.
+	[[nodiscard]] constexpr auto all_ascii(const std::string_view string) noexcept -> bool
+	{
+		std::size_t index {};
+
+		if !consteval
+		{
+#if defined(__AVX2__)
+			for (; index + 32 <= string.size(); index += 32)
+			{
+				const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(string.data() + index));
+
+				if (_mm256_movemask_epi8(block) != 0)
+				{
+					return false;
+				}
+			}
+#endif
+#if defined(__SSE2__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + index));
+
+				if (_mm_movemask_epi8(block) != 0)
+				{
+					return false;
+				}
+			}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(string.data() + index));
+
+				if (vmaxvq_u8(block) >= 0x80)
+				{
+					return false;
+				}
+			}
+#endif
+		}
+
+		for (; index < string.size(); ++index)
+		{
+			if (not is_ascii(string[index]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// @brief Test if all characters are space, alphanumeric [a-zA-Z0-9], punctuation. Vectorised where supported.
+	/// @param string Characters to test.
+	/// @return True if every character is printable, also when string is empty.
+	[[nodiscard]] constexpr auto all_printable(const std::string_view string) noexcept -> bool
 	{
-		return (character >= char {33} and character <= char {47}) or (character >= char {58} and character <= char {64})
-			   or (character >= char {91} and character <= char {96}) or (character >= char {123} and character <= char {126});
+		std::size_t index {};
+
+		if !consteval
+		{
+			/* Bytes above 127 compare as negative, which keeps them out of the signed range [32..126]. */
+#if defined(__AVX2__)
+			for (; index + 32 <= string.size(); index += 32)
+			{
+				const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(string.data() + index));
+				const auto valid = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8(31)),
+													_mm256_cmpgt_epi8(_mm256_set1_epi8(127), block));
+
+				if (_mm256_movemask_epi8(valid) != -1)
+				{
+					return false;
+				}
+			}
+#endif
+#if defined(__SSE2__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + index));
+				const auto valid = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(31)), _mm_cmplt_epi8(block, _mm_set1_epi8(127)));
+
+				if (_mm_movemask_epi8(valid) != 0xFFFF)
+				{
+					return false;
+				}
+			}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(string.data() + index));
+				const auto valid = vandq_u8(vcgeq_u8(block, vdupq_n_u8(32)), vcleq_u8(block, vdupq_n_u8(126)));
+
+				if (vminvq_u8(valid) == 0)
+				{
+					return false;
+				}
+			}
+#endif
+		}
+
+		for (; index < string.size(); ++index)
+		{
+			if (not is_printable(string[index]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// @brief Find first character not belonging to any of the classes in mask.
+	/// @brief Arbitrary class combinations do not map onto vector compares, so this is a table lookup per character.
+	/// @param string Characters to search.
+	/// @param mask Classes from `character_class`, combined with '|'.
+	/// @return Offset of first character not matching, or `std::string_view::npos` if all match.
+	[[nodiscard]] constexpr auto find_first_not(const std::string_view string, const class_mask mask) noexcept -> std::size_t
+	{
+		for (std::size_t index {}; index < string.size(); ++index)
+		{
+			if (not matches(string[index], mask))
+			{
+				return index;
+			}
+		}
+
+		return std::string_view::npos;
+	}
+
+	/// @brief Test if all characters belong to any of the classes in mask.
+	/// @param string Characters to test.
+	/// @param mask Classes from `character_class`, combined with '|'.
+	/// @return True if every character match, also when string is empty.
+	[[nodiscard]] constexpr auto all_of(const std::string_view string, const class_mask mask) noexcept -> bool
+	{ return find_first_not(string, mask) == std::string_view::npos; }
+
+	/// @brief Convert characters [A-Z] to lowercase in place, other characters unchanged. Vectorised where supported.
+	/// @param string Characters to convert.
+	constexpr void to_lowercase_in_place(const std::span<char> string) noexcept
+	{
+		std::size_t index {};
+
+		if !consteval
+		{
+#if defined(__AVX2__)
+			for (; index + 32 <= string.size(); index += 32)
+			{
+				const auto address = reinterpret_cast<__m256i*>(string.data() + index);
+				const auto block = _mm256_loadu_si256(address);
+				const auto upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+													_mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+				_mm256_storeu_si256(address, _mm256_add_epi8(block, _mm256_and_si256(upper, _mm256_set1_epi8(32))));
+			}
+#endif
+#if defined(__SSE2__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto address = reinterpret_cast<__m128i*>(string.data() + index);
+				const auto block = _mm_loadu_si128(address);
+				const auto upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+				_mm_storeu_si128(address, _mm_add_epi8(block, _mm_and_si128(upper, _mm_set1_epi8(32))));
+			}
+#elif defined(__ARM_NEON)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto address = reinterpret_cast<std::uint8_t*>(string.data() + index);
+				const auto block = vld1q_u8(address);
+				const auto upper = vandq_u8(vcgeq_u8(block, vdupq_n_u8('A')), vcleq_u8(block, vdupq_n_u8('Z')));
+				vst1q_u8(address, vaddq_u8(block, vandq_u8(upper, vdupq_n_u8(32))));
+			}
+#endif
+		}
+
+		for (; index < string.size(); ++index)
+		{
+			string[index] = to_lowercase(string[index]);
+		}
+	}
+
+	/// @brief Convert characters [a-z] to uppercase in place, other characters unchanged. Vectorised where supported.
+	/// @param string Characters to convert.
+	constexpr void to_uppercase_in_place(const std::span<char> string) noexcept
+	{
+		std::size_t index {};
+
+		if !consteval
+		{
+#if defined(__AVX2__)
+			for (; index + 32 <= string.size(); index += 32)
+			{
+				const auto address = reinterpret_cast<__m256i*>(string.data() + index);
+				const auto block = _mm256_loadu_si256(address);
+				const auto lower = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('a' - 1)),
+													_mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), block));
+				_mm256_storeu_si256(address, _mm256_sub_epi8(block, _mm256_and_si256(lower, _mm256_set1_epi8(32))));
+			}
+#endif
+#if defined(__SSE2__)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto address = reinterpret_cast<__m128i*>(string.data() + index);
+				const auto block = _mm_loadu_si128(address);
+				const auto lower = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('z' + 1)));
+				_mm_storeu_si128(address, _mm_sub_epi8(block, _mm_and_si128(lower, _mm_set1_epi8(32))));
+			}
+#elif defined(__ARM_NEON)
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				const auto address = reinterpret_cast<std::uint8_t*>(string.data() + index);
+				const auto block = vld1q_u8(address);
+				const auto lower = vandq_u8(vcgeq_u8(block, vdupq_n_u8('a')), vcleq_u8(block, vdupq_n_u8('z')));
+				vst1q_u8(address, vsubq_u8(block, vandq_u8(lower, vdupq_n_u8(32))));
+			}
+#endif
+		}
+
+		for (; index < string.size(); ++index)
+		{
+			string[index] = to_uppercase(string[index]);
+		}
+	}
+
+	/// @brief Find first offset where strings differ in ascii case-insensitive manner, within the shorter string. Vectorised where
+	/// supported.
+	/// @param left Characters to compare.
+	/// @param right Characters to compare.
+	/// @return Offset of first difference, or size of the shorter string if it is a case-insensitive prefix of the other.
+	[[nodiscard]] constexpr auto mismatch_ignore_case(const std::string_view left, const std::string_view right) noexcept -> std::size_t
+	{
+		const auto size = left.size() < right.size() ? left.size() : right.size();
+		std::size_t index {};
+
+		if !consteval
+		{
+#if defined(__AVX2__)
+			const auto lowercase_256 = [](const __m256i block) noexcept
+			{
+				const auto upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+													_mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+				return _mm256_add_epi8(block, _mm256_and_si256(upper, _mm256_set1_epi8(32)));
+			};
+
+			for (; index + 32 <= size; index += 32)
+			{
+				const auto first = lowercase_256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left.data() + index)));
+				const auto second = lowercase_256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(right.data() + index)));
+
+				if (const auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(first, second))); equal != 0xFFFFFFFF)
+				{
+					return index + static_cast<std::size_t>(std::countr_one(equal));
+				}
+			}
+#endif
+#if defined(__SSE2__)
+			const auto lowercase_128 = [](const __m128i block) noexcept
+			{
+				const auto upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+				return _mm_add_epi8(block, _mm_and_si128(upper, _mm_set1_epi8(32)));
+			};
+
+			for (; index + 16 <= size; index += 16)
+			{
+				const auto first = lowercase_128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left.data() + index)));
+				const auto second = lowercase_128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(right.data() + index)));
+
+				if (const auto equal = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(first, second))); equal != 0xFFFF)
+				{
+					return index + static_cast<std::size_t>(std::countr_one(equal));
+				}
+			}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+			const auto lowercase_128 = [](const uint8x16_t block) noexcept
+			{
+				const auto upper = vandq_u8(vcgeq_u8(block, vdupq_n_u8('A')), vcleq_u8(block, vdupq_n_u8('Z')));
+				return vaddq_u8(block, vandq_u8(upper, vdupq_n_u8(32)));
+			};
+
+			/* No movemask, so the block holding the difference is left to the scalar loop. */
+			for (; index + 16 <= size; index += 16)
+			{
+				const auto first = lowercase_128(vld1q_u8(reinterpret_cast<const std::uint8_t*>(left.data() + index)));
+				const auto second = lowercase_128(vld1q_u8(reinterpret_cast<const std::uint8_t*>(right.data() + index)));
+
+				if (vminvq_u8(vceqq_u8(first, second)) == 0)
+				{
+					break;
+				}
+			}
+#endif
+		}
+
+		for (; index < size; ++index)
+		{
+			if (to_lowercase(left[index]) != to_lowercase(right[index]))
+			{
+				return index;
+			}
+		}
+
+		return size;
+	}
+
+	/// @brief Test if strings are equal in ascii case-insensitive manner, without lowercased copies. Vectorised where supported.
+	/// @param left Characters to compare.
+	/// @param right Characters to compare.
+	/// @return True if strings have the same size and every character match ignoring case.
+	[[nodiscard]] constexpr auto equals_ignore_case(const std::string_view left, const std::string_view right) noexcept -> bool
+	{ return left.size() == right.size() and mismatch_ignore_case(left, right) == left.size(); }
+
+	/// @brief Order strings in ascii case-insensitive manner, lexicographically by unsigned lowercase characters. Vectorised where supported.
+	/// @param left Characters to compare.
+	/// @param right Characters to compare.
+	/// @return Weak ordering, as strings differing only in case are equivalent.
+	[[nodiscard]] constexpr auto compare_ignore_case(const std::string_view left, const std::string_view right) noexcept -> std::weak_ordering
+	{
+		if (const auto index = mismatch_ignore_case(left, right); index < left.size() and index < right.size())
+		{
+			return static_cast<unsigned char>(to_lowercase(left[index])) <=> static_cast<unsigned char>(to_lowercase(right[index]));
+		}
+
+		return left.size() <=> right.size();
 	}
 
 	/// @brief Ascii control character
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_registry.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Canonical media type in at most 48 bytes, for storing large numbers of them.
+	/// @brief Well-known types are stored as their `media_type_registry` identifier without any characters. Other types and the
+	/// parameters are stored inline up to `inline_capacity` characters, and only longer ones allocate.
+	class compact_media_type
+	{
+		static constexpr std::uint8_t none {0xFF};
+
+	  public:
+		/// @brief Characters of type and parameters stored without allocation.
+		static constexpr std::size_t inline_capacity {30};
+
+	  private:
+		/// @brief Characters when they do not fit inline, otherwise empty.
+		std::unique_ptr<char[]> heap;
+
+		/// @brief Characters of type, unless well-known, followed by parameters in canonical form without the leading ';'.
+		std::uint32_t length {};
+
+		/// @brief Characters of type, zero when well-known.
+		std::uint16_t type_length {};
+
+		media_type::character_offset offset {};
+
+		/// @brief Index into `media_type_registry::well_known`, or `none`.
+		std::uint8_t well_known {none};
+
+		std::array<char, inline_capacity> characters {};
+
+		static_assert(media_type_registry::well_known.size() < none);
+
+		[[nodiscard]] constexpr auto data() const noexcept -> const char* { return heap ? heap.get() : characters.data(); }
+
+		/// @brief Reserve storage for `length` characters.
+		[[nodiscard]] constexpr auto allocate() -> char*
+		{
+			if (length > inline_capacity)
+			{
+				heap = std::make_unique<char[]>(length);
+				return heap.get();
+			}
+			else
+			{
+				return characters.data();
+			}
+		}
+
+	  public:
+		/// @brief Compact copy of media type, in canonical form.
+		/// @param type Media type, in any casing.
+		[[nodiscard]] constexpr compact_media_type(const media_type_view& type)
+		{
+			std::size_t parameters_length {};
+
+			auto measure = [&](const std::string_view name, const std::string_view value, const bool quoted) noexcept
+			{
+				parameters_length += (parameters_length ? 1 : 0) + name.size() + 1 + value.size() + (quoted ? 2 : 0);
+				return true;
+			};
+
+			/* The view has already validated its parameters. */
+			static_cast<void>(media_type::parse_parameters(type.parameter_text, measure));
+
+			if (const auto result = media_type_registry::find_well_known(type))
+			{
+				well_known = static_cast<std::uint8_t>(result->id());
+			}
+			else
+			{
+				type_length = static_cast<std::uint16_t>(type.value.size());
+				offset = type.offset;
+			}
+
+			length = static_cast<std::uint32_t>(type_length + parameters_length);
+
+			auto destination = std::ranges::transform(type.value.substr(0, type_length), allocate(), ascii::to_lowercase).out;
+
+			auto write = [&](const std::string_view name, const std::string_view value, const bool quoted) noexcept
+			{
+				if (destination != data() + type_length)
+				{
+					*destination++ = ';';
+				}
+
+				destination = std::ranges::transform(name, destination, ascii::to_lowercase).out;
+				*destination++ = '=';
+
+				if (quoted)
+				{
+					*destination++ = '"';
+				}
+
+				destination = std::ranges::copy(value, destination).out;
+
+				if (quoted)
+				{
+					*destination++ = '"';
+				}
+
+				return true;
+			};
+
+			static_cast<void>(media_type::parse_parameters(type.parameter_text, write));
+		}
+
+		/// @brief Compact copy of media type. Does not parse again.
+		/// @param type Media type.
+		[[nodiscard]] constexpr compact_media_type(const media_type& type) : compact_media_type {media_type_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr compact_media_type(const std::string_view type) : compact_media_type {media_type_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Null-terminated media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr compact_media_type(const char* const type) : compact_media_type {media_type_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr compact_media_type(const std::string& type) : compact_media_type {media_type_view {type}} { }
+
+		[[nodiscard]] constexpr compact_media_type(const compact_media_type& other) :
+			length {other.length}, type_length {other.type_length}, offset {other.offset}, well_known {other.well_known},
+			characters {other.characters}
+		{
+			if (other.heap)
+			{
+				std::ranges::copy(other.data(), other.data() + length, allocate());
+			}
+		}
+
+		/// @brief Moved-from object is left empty, rather than referring to characters it no longer owns.
+		[[nodiscard]] constexpr compact_media_type(compact_media_type&& other) noexcept :
+			heap {std::move(other.heap)}, length {std::exchange(other.length, 0)}, type_length {std::exchange(other.type_length, 0)},
+			offset {std::exchange(other.offset, {})}, well_known {std::exchange(other.well_known, none)}, characters {other.characters}
+		{ }
+
+		constexpr auto operator=(const compact_media_type& other) -> compact_media_type&
+		{
+			if (this != &other)
+			{
+				*this = compact_media_type {other};
+			}
+
+			return *this;
+		}
+
+		constexpr auto operator=(compact_media_type&& other) noexcept -> compact_media_type&
+		{
+			heap = std::move(other.heap);
+			length = std::exchange(other.length, 0);
+			type_length = std::exchange(other.type_length, 0);
+			offset = std::exchange(other.offset, {});
+			well_known = std::exchange(other.well_known, none);
+			characters = other.characters;
+			return *this;
+		}
+
+		constexpr ~compact_media_type() = default;
+
+		/// @brief Get as view, valid as long as this object is neither modified nor destroyed.
+		[[nodiscard]] constexpr auto view() const noexcept -> media_type_view
+		{
+			const std::string_view text {data(), length};
+
+			if (well_known != none)
+			{
+				const auto& known = media_type_registry::well_known[well_known];
+				return media_type_view {known.value, text, known.offset};
+			}
+			else
+			{
+				return media_type_view {text.substr(0, type_length), text.substr(type_length), offset};
+			}
+		}
+
+		[[nodiscard]] constexpr operator media_type_view() const noexcept { return view(); }
+
+		/// @brief Copy into an owning media type. Does not parse again.
+		[[nodiscard]] constexpr explicit operator media_type() const { return media_type {view()}; }
+
+		/// @brief Well-known types compare by identifier alone.
+		[[nodiscard]] constexpr auto operator==(const compact_media_type& other) const noexcept -> bool
+		{ return well_known == other.well_known and (well_known != none or view() == other.view()); };
+		[[nodiscard]] constexpr auto operator==(const media_type& other) const noexcept -> bool { return view() == other; };
+		[[nodiscard]] constexpr auto operator==(const media_type_view& other) const noexcept -> bool { return view() == other; };
+		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool { return view() == other; };
+		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool { return view() == other; };
+
+		/// @brief Check if characters are stored without allocation.
+		[[nodiscard]] constexpr auto is_inline() const noexcept -> bool { return not heap; }
+
+		/// @brief Check if type is stored as `media_type_registry` identifier.
+		[[nodiscard]] constexpr auto is_well_known() const noexcept -> bool { return well_known != none; }
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
+		[[nodiscard]] constexpr auto string() const noexcept -> std::string_view { return view().string(); }
+
+		/// @brief Get top-level type.
+		[[nodiscard]] constexpr auto type() const noexcept -> std::string_view { return view().type(); }
+
+		/// @brief Get registration tree.
+		[[nodiscard]] constexpr auto tree() const noexcept -> std::string_view { return view().tree(); }
+
+		/// @brief Get subtype.
+		[[nodiscard]] constexpr auto subtype() const noexcept -> std::string_view { return view().subtype(); }
+
+		/// @brief Get structured type name suffix.
+		[[nodiscard]] constexpr auto suffix() const noexcept -> std::string_view { return view().suffix(); }
+
+		/// @brief Check if media type is in standards tree.
+		/// @return True if media type is in standards tree.
+		[[nodiscard]] constexpr auto in_standards_tree() const noexcept -> bool { return view().in_standards_tree(); }
+
+		/// @brief Get value of parameter. Parameters are parsed again on every call, without allocation.
+		/// @param name Parameter name, compared case-insensitively.
+		/// @return Value of first parameter with name, or nothing if there is none.
+		[[nodiscard]] constexpr auto parameter(const std::string_view name) const noexcept -> std::optional<std::string_view>
+		{ return view().parameter(name); }
+
+		/// @brief Get all parameters in order.
+		[[nodiscard]] constexpr auto parameters() const -> media_type::parameter_list { return view().parameters(); }
+
+		/// @brief Get parameters in canonical form 'name=value;name="value"', without the leading ';'.
+		[[nodiscard]] constexpr auto parameters_string() const noexcept -> std::string_view { return view().parameters_string(); }
+	};
+
+	static_assert(sizeof(compact_media_type) <= 48);
+}
+
+template<>
+struct std::formatter<common_good::compact_media_type> : common_good::media_type_formatter
+{
+	/// @brief Parameters are stored in canonical form.
+	constexpr auto format(const common_good::compact_media_type& media_type, auto&& context) const
+	{
+		const auto view = media_type.view();
+		return write({view.string(), view.type(), view.tree(), view.subtype(), view.suffix(), view.parameters_string(), true}, context);
+	}
+};
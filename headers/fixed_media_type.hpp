@@ -0,0 +1,222 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief Canonical media type in a fixed-capacity array, a literal type for `constinit` and `constexpr` tables that need no
+	/// dynamic initialisation.
+	/// @brief Same canonical form and offset layout as `media_type`, so converting between the two does not parse again.
+	/// @tparam Capacity Characters of type and parameters stored, parameters in canonical form without the leading ';'.
+	template<std::size_t Capacity = 64>
+	class fixed_media_type
+	{
+		static_assert(Capacity <= 0xFFFF);
+
+		template<std::size_t>
+		friend class fixed_media_type;
+
+		/// @brief Characters of type, followed by parameters in canonical form without the leading ';'.
+		std::array<char, Capacity> characters {};
+
+		std::uint16_t length {};
+
+		/// @brief Characters of type.
+		std::uint16_t type_length {};
+
+		media_type::character_offset offset {};
+
+	  public:
+		/// @brief Copy of media type, in canonical form.
+		/// @param type Media type, in any casing.
+		/// @exception std::length_error If type and parameters do not fit in `Capacity` characters.
+		[[nodiscard]] constexpr fixed_media_type(const media_type_view& type)
+		{
+			std::size_t parameters_length {};
+
+			auto measure = [&](const std::string_view name, const std::string_view value, const bool quoted) noexcept
+			{
+				parameters_length += (parameters_length ? 1 : 0) + name.size() + 1 + value.size() + (quoted ? 2 : 0);
+				return true;
+			};
+
+			/* The view has already validated its parameters. */
+			static_cast<void>(media_type::parse_parameters(type.parameter_text, measure));
+
+			if (type.value.size() + parameters_length > Capacity)
+			{
+				throw std::length_error {"fixed media type: longer than capacity"};
+			}
+
+			type_length = static_cast<std::uint16_t>(type.value.size());
+			length = static_cast<std::uint16_t>(type_length + parameters_length);
+			offset = type.offset;
+
+			auto destination = std::ranges::transform(type.value, characters.begin(), ascii::to_lowercase).out;
+
+			auto write = [&](const std::string_view name, const std::string_view value, const bool quoted) noexcept
+			{
+				if (destination != characters.begin() + type_length)
+				{
+					*destination++ = ';';
+				}
+
+				destination = std::ranges::transform(name, destination, ascii::to_lowercase).out;
+				*destination++ = '=';
+
+				if (quoted)
+				{
+					*destination++ = '"';
+				}
+
+				destination = std::ranges::copy(value, destination).out;
+
+				if (quoted)
+				{
+					*destination++ = '"';
+				}
+
+				return true;
+			};
+
+			static_cast<void>(media_type::parse_parameters(type.parameter_text, write));
+		}
+
+		/// @brief Copy of media type. Does not parse again.
+		/// @param type Media type using any allocator.
+		/// @exception std::length_error If type and parameters do not fit in `Capacity` characters.
+		template<typename Allocator>
+		[[nodiscard]] constexpr fixed_media_type(const basic_media_type<Allocator>& type) : fixed_media_type {media_type_view {type}}
+		{ }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		/// @exception std::length_error If type and parameters do not fit in `Capacity` characters.
+		[[nodiscard]] constexpr fixed_media_type(const std::string_view type) : fixed_media_type {media_type_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Null-terminated media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		/// @exception std::length_error If type and parameters do not fit in `Capacity` characters.
+		[[nodiscard]] constexpr fixed_media_type(const char* const type) : fixed_media_type {media_type_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @exception media_type::parsing_error If string fail to parse.
+		/// @exception std::length_error If type and parameters do not fit in `Capacity` characters.
+		[[nodiscard]] constexpr fixed_media_type(const std::string& type) : fixed_media_type {media_type_view {type}} { }
+
+		/// @brief Get as view, valid as long as this object is neither modified nor destroyed.
+		[[nodiscard]] constexpr auto view() const noexcept -> media_type_view
+		{
+			const std::string_view text {characters.data(), length};
+			return media_type_view {text.substr(0, type_length), text.substr(type_length), offset};
+		}
+
+		[[nodiscard]] constexpr operator media_type_view() const noexcept { return view(); }
+
+		/// @brief Copy into an owning media type. Does not parse again.
+		[[nodiscard]] constexpr explicit operator media_type() const { return media_type {view()}; }
+
+		/// @brief Get number of characters stored at most.
+		[[nodiscard]] constexpr static auto capacity() noexcept -> std::size_t { return Capacity; }
+
+		/// @brief Both sides are canonical, so this is a plain comparison of the types.
+		template<std::size_t OtherCapacity>
+		[[nodiscard]] constexpr auto operator==(const fixed_media_type<OtherCapacity>& other) const noexcept -> bool
+		{ return string() == other.string(); };
+		template<typename Allocator>
+		[[nodiscard]] constexpr auto operator==(const basic_media_type<Allocator>& other) const noexcept -> bool
+		{ return string() == std::string_view {other.string()}; };
+		[[nodiscard]] constexpr auto operator==(const media_type_view& other) const noexcept -> bool { return view() == other; };
+		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool { return view() == other; };
+		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool { return view() == other; };
+
+		/// @brief Orders as `media_type`, by component ignoring case.
+		template<std::size_t OtherCapacity>
+		[[nodiscard]] constexpr auto operator<=>(const fixed_media_type<OtherCapacity>& other) const noexcept -> std::weak_ordering
+		{ return view() <=> other.view(); };
+		template<typename Allocator>
+		[[nodiscard]] constexpr auto operator<=>(const basic_media_type<Allocator>& other) const noexcept -> std::weak_ordering
+		{ return view() <=> other; };
+		[[nodiscard]] constexpr auto operator<=>(const media_type_view& other) const noexcept -> std::weak_ordering
+		{ return view() <=> other; };
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
+		[[nodiscard]] constexpr auto string() const noexcept -> std::string_view { return {characters.data(), type_length}; }
+
+		/// @brief Get top-level type.
+		[[nodiscard]] constexpr auto type() const noexcept -> std::string_view { return view().type(); }
+
+		/// @brief Get registration tree.
+		[[nodiscard]] constexpr auto tree() const noexcept -> std::string_view { return view().tree(); }
+
+		/// @brief Get subtype.
+		[[nodiscard]] constexpr auto subtype() const noexcept -> std::string_view { return view().subtype(); }
+
+		/// @brief Get structured type name suffix.
+		[[nodiscard]] constexpr auto suffix() const noexcept -> std::string_view { return view().suffix(); }
+
+		/// @brief Get structured syntax suffix, for dispatch without comparing strings.
+		[[nodiscard]] constexpr auto structured_suffix() const noexcept -> common_good::structured_suffix
+		{ return view().structured_suffix(); }
+
+		/// @brief Get top-level type, for dispatch without comparing strings.
+		[[nodiscard]] constexpr auto top_level_type() const noexcept -> common_good::top_level_type { return view().top_level_type(); }
+
+		/// @brief Check if media type is in standards tree.
+		/// @return True if media type is in standards tree.
+		[[nodiscard]] constexpr auto in_standards_tree() const noexcept -> bool { return not offset.after_possible_first_dot; }
+
+		/// @brief Get value of parameter. Parameters are parsed again on every call, without allocation.
+		/// @param name Parameter name, compared case-insensitively.
+		/// @return Value of first parameter with name, or nothing if there is none.
+		[[nodiscard]] constexpr auto parameter(const std::string_view name) const noexcept -> std::optional<std::string_view>
+		{ return view().parameter(name); }
+
+		/// @brief Get all parameters in order.
+		[[nodiscard]] constexpr auto parameters() const -> media_type::parameter_list { return view().parameters(); }
+
+		/// @brief Get parameters in canonical form 'name=value;name="value"', without the leading ';'.
+		[[nodiscard]] constexpr auto parameters_string() const noexcept -> std::string_view
+		{ return {characters.data() + type_length, static_cast<std::size_t>(length - type_length)}; }
+
+		/// @brief Get hash of type, parameters not included. Equal to the hash of an equal `media_type`.
+		[[nodiscard]] constexpr auto hash() const noexcept -> std::size_t { return media_type::hash_ignore_case(string()); }
+	};
+
+	static_assert(sizeof(fixed_media_type<>) <= 72);
+}
+
+template<std::size_t Capacity>
+struct std::hash<common_good::fixed_media_type<Capacity>>
+{
+	[[nodiscard]] constexpr auto operator()(const common_good::fixed_media_type<Capacity>& type) const noexcept -> std::size_t
+	{ return type.hash(); }
+};
+
+template<std::size_t Capacity>
+struct std::formatter<common_good::fixed_media_type<Capacity>> : common_good::media_type_formatter
+{
+	/// @brief Parameters are stored in canonical form.
+	constexpr auto format(const common_good::fixed_media_type<Capacity>& media_type, auto&& context) const
+	{
+		const auto view = media_type.view();
+		return write({view.string(), view.type(), view.tree(), view.subtype(), view.suffix(), view.parameters_string(), true}, context);
+	}
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace common_good
+{
+	/// @brief Sorted associative container keyed by media type, in a single contiguous vector for read-mostly tables such as handler
+	/// registries with hundreds of entries.
+	/// @brief Ordered as `media_type`, by component ignoring case. Lookups take media types, views or strings and never allocate.
+	/// @brief Insertion and erasure move every later entry, so build in bulk where possible.
+	/// @tparam Type Value associated with each media type.
+	template<typename Type>
+	class flat_media_type_map
+	{
+	  public:
+		using key_type = media_type;
+		using mapped_type = Type;
+		using value_type = std::pair<media_type, Type>;
+		using size_type = std::size_t;
+		using iterator = typename std::vector<value_type>::iterator;
+		using const_iterator = typename std::vector<value_type>::const_iterator;
+
+	  private:
+		std::vector<value_type> entries;
+
+		/// @brief View of key, parsing strings without allocation.
+		/// @return View, or nothing if key is a string that fail to parse, which then matches no entry.
+		template<typename Key>
+		[[nodiscard]] constexpr static auto view(const Key& key) noexcept -> std::optional<media_type_view>
+		{
+			if constexpr (std::convertible_to<const Key&, std::string_view>)
+			{
+				if (const auto result = media_type_view::try_parse(key); result)
+				{
+					return *result;
+				}
+
+				return std::nullopt;
+			}
+			else
+			{
+				return media_type_view {key};
+			}
+		}
+
+		/// @brief First entry not ordered before key.
+		[[nodiscard]] constexpr auto lower_bound(const media_type_view key) const noexcept -> const_iterator
+		{ return std::ranges::partition_point(entries, [&](const value_type& entry) noexcept { return (key <=> entry.first) > 0; }); }
+
+		/// @brief Entry equal to key, or end.
+		[[nodiscard]] constexpr auto search(const std::optional<media_type_view> key) const noexcept -> const_iterator
+		{
+			if (not key)
+			{
+				return entries.end();
+			}
+
+			const auto position = lower_bound(*key);
+			return position != entries.end() and *key == position->first ? position : entries.end();
+		}
+
+	  public:
+		[[nodiscard]] constexpr flat_media_type_map() = default;
+
+		/// @brief Map of entries in any order, sorted once. Of entries with equal media types the first is kept, as for `std::map`.
+		/// @param entries Media types and their values.
+		[[nodiscard]] explicit flat_media_type_map(std::vector<value_type> entries) : entries {std::move(entries)}
+		{
+			std::ranges::stable_sort(this->entries, std::ranges::less {}, &value_type::first);
+
+			const auto duplicates = std::ranges::unique(this->entries, std::ranges::equal_to {}, &value_type::first);
+			this->entries.erase(duplicates.begin(), duplicates.end());
+		}
+
+		/// @brief Map of entries in any order, sorted once. Of entries with equal media types the first is kept, as for `std::map`.
+		/// @param entries Media types and their values.
+		[[nodiscard]] flat_media_type_map(const std::initializer_list<value_type> entries) :
+			flat_media_type_map {std::vector<value_type> {entries}}
+		{ }
+
+		/// @brief Find entry of media type.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		/// @return Entry, or end if there is none or key is a string that fail to parse.
+		template<typename Key>
+		[[nodiscard]] constexpr auto find(const Key& key) const noexcept -> const_iterator
+		{ return search(view(key)); }
+
+		/// @brief Find entry of media type.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		/// @return Entry, or end if there is none or key is a string that fail to parse.
+		template<typename Key>
+		[[nodiscard]] constexpr auto find(const Key& key) noexcept -> iterator
+		{ return entries.begin() + (search(view(key)) - entries.cbegin()); }
+
+		/// @brief Test if map has entry of media type.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		template<typename Key>
+		[[nodiscard]] constexpr auto contains(const Key& key) const noexcept -> bool
+		{ return search(view(key)) != entries.end(); }
+
+		/// @brief Get value of media type.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		/// @exception std::out_of_range If map has no entry of media type.
+		template<typename Key>
+		[[nodiscard]] constexpr auto at(const Key& key) const -> const Type&
+		{
+			if (const auto position = find(key); position != entries.end())
+			{
+				return position->second;
+			}
+
+			throw std::out_of_range {"flat media type map: no such media type"};
+		}
+
+		/// @brief Get value of media type.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		/// @exception std::out_of_range If map has no entry of media type.
+		template<typename Key>
+		[[nodiscard]] constexpr auto at(const Key& key) -> Type&
+		{ return const_cast<Type&>(std::as_const(*this).at(key)); }
+
+		/// @brief Add entry unless map already has one of the same media type.
+		/// @param entry Media type and its value.
+		/// @return Entry of media type, and whether it was added.
+		constexpr auto insert(value_type entry) -> std::pair<iterator, bool>
+		{
+			const auto position = entries.begin() + (lower_bound(media_type_view {entry.first}) - entries.cbegin());
+
+			if (position != entries.end() and position->first == entry.first)
+			{
+				return {position, false};
+			}
+
+			return {entries.insert(position, std::move(entry)), true};
+		}
+
+		/// @brief Add entry, replacing the value of an entry of the same media type.
+		/// @param type Media type.
+		/// @param value Value of media type.
+		/// @return Entry of media type, and whether it was added rather than replaced.
+		constexpr auto insert_or_assign(media_type type, Type value) -> std::pair<iterator, bool>
+		{
+			const auto position = entries.begin() + (lower_bound(media_type_view {type}) - entries.cbegin());
+
+			if (position != entries.end() and position->first == type)
+			{
+				position->second = std::move(value);
+				return {position, false};
+			}
+
+			return {entries.emplace(position, std::move(type), std::move(value)), true};
+		}
+
+		/// @brief Remove entry.
+		/// @return Entry following the removed entry.
+		constexpr auto erase(const const_iterator position) -> iterator { return entries.erase(position); }
+
+		/// @brief Remove entry of media type, if any.
+		/// @param key Media type, view, or string in format 'type/tree.subtype+suffix'. Parameters are not considered.
+		/// @return Number of entries removed, zero or one.
+		template<typename Key>
+			requires (not std::same_as<Key, const_iterator> and not std::same_as<Key, iterator>)
+		constexpr auto erase(const Key& key) -> size_type
+		{
+			if (const auto position = search(view(key)); position != entries.end())
+			{
+				entries.erase(position);
+				return 1;
+			}
+
+			return 0;
+		}
+
+		/// @brief Remove every entry.
+		constexpr void clear() noexcept { entries.clear(); }
+
+		/// @brief Get entries, sorted by media type.
+		[[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return entries.begin(); }
+		[[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return entries.end(); }
+
+		/// @brief Get entries, sorted by media type. Values may be modified, media types must not.
+		[[nodiscard]] constexpr auto begin() noexcept -> iterator { return entries.begin(); }
+		[[nodiscard]] constexpr auto end() noexcept -> iterator { return entries.end(); }
+
+		/// @brief Get number of entries.
+		[[nodiscard]] constexpr auto size() const noexcept -> size_type { return entries.size(); }
+
+		/// @brief Test if map has no entries.
+		[[nodiscard]] constexpr auto empty() const noexcept -> bool { return entries.empty(); }
+	};
+}
@@ -7,15 +7,21 @@
 */
 
 #include "ascii.hpp"
+#include "small_vector.hpp"
+#include "stats.hpp"
 
 #include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <expected>
 #include <format>
-#include <initializer_list>
-#include <iterator>
-#include <map>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <optional>
-#include <ranges>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -23,9 +29,173 @@
 
 namespace common_good
 {
-	/// @brief Media type as defined by RFC 6838.
-	class media_type
+	class media_type_view;
+
+	template<typename Allocator>
+	class basic_media_type;
+
+	/// @brief Structured syntax suffix of a media type, as registered with IANA under RFC 6838 and RFC 6839.
+	/// @brief Computed once on parse, so serializers can be chosen by a switch rather than by comparing strings.
+	enum class structured_suffix : unsigned char
+	{
+		/// @brief Media type has no suffix.
+		none,
+
+		/// @brief Suffix is valid but not registered.
+		other,
+
+		xml,
+		json,
+		ber,
+		cbor,
+		der,
+		fastinfoset,
+		wbxml,
+		zip,
+		tlv,
+		json_seq,
+		sqlite3,
+		jwt,
+		gzip,
+		cbor_seq,
+		zstd,
+		yaml,
+	};
+
+	/// @brief Top-level type of a media type, as registered with IANA.
+	enum class top_level_type : unsigned char
+	{
+		/// @brief Top-level type is valid but not registered.
+		other,
+
+		application,
+		audio,
+		example,
+		font,
+		haptics,
+		image,
+		message,
+		model,
+		multipart,
+		text,
+		video,
+	};
+
+	/// @brief Grammar, errors and helpers shared by every `basic_media_type`, independent of its allocator.
+	class media_type_base
 	{
+		friend class media_type_view;
+		friend class accept_list;
+		friend class compact_media_type;
+		friend class media_type_parser;
+		friend class media_type_formatter;
+		friend class media_type_cache;
+		friend class multipart_parser;
+		template<typename>
+		friend class basic_media_type;
+		template<std::size_t>
+		friend class fixed_media_type;
+
+	  public:
+		/// @brief Reason a string fail to parse as media type.
+		enum class error : unsigned char
+		{
+			missing_slash,
+			missing_tree,
+			type_length,
+			type_first_character,
+			type_character,
+			tree_length,
+			tree_first_character,
+			tree_last_character,
+			tree_character,
+			subtype_length,
+			subtype_first_character,
+			subtype_character,
+			suffix_length,
+			suffix_first_character,
+			suffix_second_character,
+			suffix_character,
+			parameter_name,
+			parameter_missing_equals,
+			parameter_value,
+			parameter_unterminated_quote,
+			parameter_missing_semicolon,
+			parameter_weight,
+		};
+
+		static_assert(std::to_underlying(error::parameter_weight) < stats::failure_kinds);
+
+		/// @brief Get human readable description of error.
+		/// @param code Error to describe.
+		/// @return Static null-terminated string.
+		[[nodiscard]] constexpr static auto message(const error code) noexcept -> const char*
+		{
+			switch (code)
+			{
+				case error::missing_slash: return "media type: parsing: missing delimiter '/' after type";
+				case error::missing_tree: return "media type: parsing: missing tree between delimiter '/' and '.'";
+				case error::type_length: return "media type: top-level type: lenght required to be [1..127] characters";
+				case error::type_first_character: return "media type: top-level type: first character required to be alphanumeric";
+				case error::type_character: return "media type: top-level type: containing non-valid characters";
+				case error::tree_length: return "media type: tree: lenght required to be [2..127] characters";
+				case error::tree_first_character: return "media type: tree: first character required to be alphanumeric";
+				case error::tree_last_character: return "media type: tree: last character required to be '.'";
+				case error::tree_character: return "media type: tree: containing non-valid characters";
+				case error::subtype_length: return "media type: subtype: lenght required to be [1..127] characters";
+				case error::subtype_first_character: return "media type: subtype: first character required to be alphanumeric";
+				case error::subtype_character: return "media type: subtype: containing non-valid characters";
+				case error::suffix_length: return "media type: suffix: lenght required to be [2..127] characters";
+				case error::suffix_first_character: return "media type: suffix: first character required to be '+'";
+				case error::suffix_second_character: return "media type: suffix: second character required to be alphanumeric";
+				case error::suffix_character: return "media type: suffix: containing non-valid characters";
+				case error::parameter_name: return "media type: parameter: name required to be non-empty token";
+				case error::parameter_missing_equals: return "media type: parameter: missing delimiter '=' after name";
+				case error::parameter_value: return "media type: parameter: value required to be non-empty token or quoted-string";
+				case error::parameter_unterminated_quote: return "media type: parameter: quoted-string missing closing '\"'";
+				case error::parameter_missing_semicolon: return "media type: parameter: missing delimiter ';' after value";
+				case error::parameter_weight: return "media type: parameter: weight required to be qvalue in [0..1] with at most three decimals";
+			}
+
+			return "media type: unknown error";
+		}
+
+		/// @brief Hash type in ascii case-insensitive manner, as FNV-1a of the lowercase characters.
+		/// @brief Equal to `hash()` of any media type comparing equal to string, so containers can be searched without a `media_type`.
+		/// @param string Media type in format 'type/tree.subtype+suffix', in any casing.
+		[[nodiscard]] constexpr static auto hash_ignore_case(const std::string_view string) noexcept -> std::size_t
+		{
+			std::uint64_t hash {14695981039346656037u};
+
+			for (const auto character : string)
+			{
+				hash = (hash ^ static_cast<unsigned char>(ascii::to_lowercase(character))) * 1099511628211u;
+			}
+
+			return static_cast<std::size_t>(hash);
+		}
+
+		/// @brief Parameter names and values. A value is either a token, or the content of a quoted-string with any quoted-pair
+		/// escapes left as is.
+		using parameter_list = small_vector<std::pair<std::string_view, std::string_view>, 4>;
+
+		/// @brief Find media type of file extension, in a table laid out at compile time. Does not allocate.
+		/// @param extension File extension with or without leading '.', compared case-insensitively.
+		/// @return View of static storage, or nothing if extension is unknown. Defined in 'media_type_extension.hpp'.
+		[[nodiscard]] constexpr static auto from_extension(std::string_view extension) noexcept -> std::optional<media_type_view>;
+
+		class parsing_error : public std::invalid_argument
+		{
+			error reason;
+
+		  public:
+			[[nodiscard]] explicit parsing_error(const error code) noexcept : std::invalid_argument {message(code)}, reason {code} { };
+
+			/// @brief Get the reason the string fail to parse.
+			[[nodiscard]] auto code() const noexcept -> error { return reason; }
+		};
+
+	  private:
 		struct character_offset
 		{
 			unsigned char after_slash {};
@@ -33,312 +203,812 @@ namespace common_good
 			unsigned char possible_last_plus {};
 		};
 
-		std::string value;
+		/// @brief No default member initializers, as those would make the type incomplete for `small_vector` inside this class.
+		struct parameter_offset
+		{
+			std::uint32_t name;
+			std::uint32_t name_size;
+			std::uint32_t value;
+			std::uint32_t value_size;
+		};
 
-		/// @brief By using numeric offsets instead of iterators the class is copy/move friendly.
-		character_offset offset {};
+		/// @brief Compare two strings in ascii case-insensitive manner.
+		[[nodiscard]] constexpr static auto equals_ignore_case(const std::string_view left, const std::string_view right) noexcept -> bool
+		{ return ascii::equals_ignore_case(left, right); }
+
+		/// @brief Names of `structured_suffix` in order of the enumeration, empty for those without a name.
+		static constexpr std::array<std::string_view, 18> suffix_names {
+			"", "", "xml", "json", "ber", "cbor", "der", "fastinfoset", "wbxml", "zip", "tlv", "json-seq", "sqlite3", "jwt", "gzip", "cbor-seq",
+			"zstd", "yaml"};
+
+		/// @brief Names of `top_level_type` in order of the enumeration, empty for those without a name.
+		static constexpr std::array<std::string_view, 12> top_level_names {
+			"", "application", "audio", "example", "font", "haptics", "image", "message", "model", "multipart", "text", "video"};
 
-		/// @brief Test if string only contain alphanumeric lowercase characters or '!', '#', '$', '&', '-', '^', '_', '.', '+'.
-		/// @param string String to test.
-		/// @return True if string only contain allowed characters.
-		[[nodiscard]] static constexpr auto is_restricted_name(const std::string_view string) noexcept
+		/// @brief Classify suffix in ascii case-insensitive manner.
+		/// @param suffix Suffix with its leading '+', as the accessors, or empty if there is none.
+		[[nodiscard]] constexpr static auto classify_suffix(const std::string_view suffix) noexcept -> structured_suffix
 		{
-			auto predicate = [](const char character) noexcept
+			if (suffix.empty())
 			{
-				static constexpr auto list = {'!', '#', '$', '&', '-', '^', '_', '.', '+'};
-				return ascii::is_alphanumeric_lowercase(character) or std::ranges::contains(list, character);
-			};
+				return structured_suffix::none;
+			}
+
+			for (std::size_t index {2}; index < suffix_names.size(); ++index)
+			{
+				if (equals_ignore_case(suffix.substr(1), suffix_names[index]))
+				{
+					return static_cast<structured_suffix>(index);
+				}
+			}
 
-			return std::ranges::all_of(string, predicate);
+			return structured_suffix::other;
 		}
 
-		/// @brief Test if string only contain alphanumeric lowercase characters or '!', '#', '$', '&', '-', '^', '_'.
-		/// @brief Same as `is_restricted_name(string_view)` but not allowing '.' or '+'.
-		/// @param string String to test.
-		/// @return True if string only contain allowed characters.
-		[[nodiscard]] static constexpr auto is_modified_restricted_name(const std::string_view string) noexcept
+		/// @brief Classify top-level type in ascii case-insensitive manner.
+		[[nodiscard]] constexpr static auto classify_top_level_type(const std::string_view type) noexcept -> top_level_type
 		{
-			auto predicate = [](const char character) noexcept
+			for (std::size_t index {1}; index < top_level_names.size(); ++index)
 			{
-				static constexpr auto list = {'!', '#', '$', '&', '-', '^', '_'};
-				return ascii::is_alphanumeric_lowercase(character) or std::ranges::contains(list, character);
-			};
+				if (equals_ignore_case(type, top_level_names[index]))
+				{
+					return static_cast<top_level_type>(index);
+				}
+			}
 
-			return std::ranges::all_of(string, predicate);
+			return top_level_type::other;
 		}
 
-		/// @brief Validate top-level type.
-		/// @param input Top-level type in format 'type'.
-		/// @exception media_type::parsing_error If string is empty.
-		/// @exception media_type::parsing_error If string is not less than 128 characters.
-		/// @exception media_type::parsing_error If first character is not alphanumeric.
-		/// @exception media_type::parsing_error If remainder of string is not alphanumeric or '!', '#', '$', '&', '-',
-		/// '^', '_', '.', '+'.
-		constexpr static void validate_type(const std::string_view value)
+		/// @brief Split type into top-level type, tree, subtype and suffix, as the accessors.
+		[[nodiscard]] constexpr static auto split(const std::string_view type, const character_offset offset) noexcept
+			-> std::array<std::string_view, 4>
 		{
-			if (value.empty() or value.size() > 127)
-			{
-				throw parsing_error {"media type: top-level type: lenght required to be [1..127] characters"};
-			}
+			const auto start = static_cast<std::size_t>(offset.after_slash) + static_cast<std::size_t>(offset.after_possible_first_dot);
 
-			if (not ascii::is_alphanumeric_lowercase(value.front()))
+			if (offset.possible_last_plus)
 			{
-				throw parsing_error {"media type: top-level type: first character required to be alphanumeric"};
+				return {type.substr(0, offset.after_slash - 1), type.substr(offset.after_slash, offset.after_possible_first_dot),
+						type.substr(start, offset.possible_last_plus), type.substr(start + offset.possible_last_plus)};
 			}
-
-			if (not is_restricted_name(value))
+			else
 			{
-				throw parsing_error {"media type: top-level type: containing non-valid characters"};
+				return {type.substr(0, offset.after_slash - 1), type.substr(offset.after_slash, offset.after_possible_first_dot),
+						type.substr(start), {}};
 			}
 		}
 
-		/// @brief Validate registration tree.
-		/// @param input Registration tree in format '' (empty, standards tree) or 'tree.'
-		/// @exception media_type::parsing_error If string is not less than 128 characters.
-		/// @exception media_type::parsing_error If first character is not alphanumeric.
-		/// @exception media_type::parsing_error If remainder of string is not alphanumeric or '!', '#', '$', '&', '-',
-		/// '^', '_'.
-		/// @exception media_type::parsing_error If last character is not '.'.
-		constexpr static void validate_tree(const std::string_view value)
+		/// @brief Order two types by top-level type, tree, subtype and suffix in turn, each in ascii case-insensitive manner.
+		/// @brief Unlike ordering the whole strings, a component sorts before any longer one it is a prefix of, whatever follows it.
+		[[nodiscard]] constexpr static auto compare_components(const std::string_view left,
+															   const character_offset left_offset,
+															   const std::string_view right,
+															   const character_offset right_offset) noexcept -> std::weak_ordering
 		{
-			if (value.empty())
+			const auto first = split(left, left_offset);
+			const auto second = split(right, right_offset);
+
+			for (std::size_t index {}; index < first.size(); ++index)
 			{
-				return;
+				if (const auto order = ascii::compare_ignore_case(first[index], second[index]); order != 0)
+				{
+					return order;
+				}
 			}
 
-			if (value.size() < 2 or value.size() > 127)
+			return std::weak_ordering::equivalent;
+		}
+
+		/// @brief Test if character is alphanumeric or '!', '#', '$', '&', '-', '^', '_'.
+		/// @param character Character to test.
+		/// @return True if character is allowed.
+		[[nodiscard]] static constexpr auto is_modified_restricted_name(const char character) noexcept -> bool
+		{ return ascii::matches(character, ascii::character_class::modified_restricted_name); }
+
+		/// @brief Test if character is alphanumeric or '!', '#', '$', '&', '-', '^', '_', '.', '+'.
+		/// @brief Same as `is_modified_restricted_name(char)` but also allowing '.' or '+'.
+		/// @param character Character to test.
+		/// @return True if character is allowed.
+		[[nodiscard]] static constexpr auto is_restricted_name(const char character) noexcept -> bool
+		{ return ascii::matches(character, ascii::character_class::restricted_name); }
+
+		/// @brief Single forward pass parser, validating and recording offsets one character at a time.
+		/// @brief Characters are classified case-insensitively. Parsing stops at the first ';', which begins the parameters, and
+		/// whitespace before it is not part of the media type.
+		/// @brief Errors are reported in the same order as the grammar is read: missing '/', top-level type, missing tree, tree,
+		/// subtype and last suffix. Top-level type and tree are validated as soon as their delimiter is seen, the remainder when finished.
+		class scanner
+		{
+			static constexpr auto none = std::string_view::npos;
+
+			/// @brief Characters of the type consumed, not counting blanks still pending nor the terminating ';'.
+			std::size_t consumed {};
+
+			/// @brief Offset of the character after '/', zero while still reading the top-level type.
+			std::size_t after_slash {};
+
+			/// @brief Offset of the character after the first '.' relative to `after_slash`, zero if no '.' has been seen.
+			std::size_t after_first_dot {};
+
+			/// @brief Characters in the current segment: top-level type, possible tree and subtype, or subtype and suffix.
+			std::size_t segment {};
+
+			/// @brief Offset within segment of the last '+'.
+			std::size_t last_plus {none};
+
+			/// @brief Offset within segment of the first character not allowed in a subtype.
+			std::size_t first_invalid_subtype {none};
+
+			/// @brief Offset within segment of the last character not allowed in a suffix, '+' not included.
+			std::size_t last_invalid_suffix {none};
+
+			/// @brief Blanks after '/' not yet known to be followed by anything but ';'.
+			std::size_t pending_blanks {};
+
+			/// @brief Offset of the first character after the terminating ';'.
+			std::size_t after_semicolon {none};
+
+			std::optional<error> failure {};
+			bool first_character_valid {};
+			bool character_after_plus_valid {};
+			bool segment_valid {true};
+
+			constexpr auto fail(const error code) noexcept -> bool
 			{
-				throw parsing_error {"media type: tree: lenght required to be [2..127] characters"};
+				failure = code;
+				return false;
 			}
-			else
+
+			/// @brief Validate top-level type as '/' is seen.
+			constexpr auto on_slash() noexcept -> bool
 			{
-				if (not ascii::is_alphanumeric_lowercase(value.front()))
+				if (segment == 0 or segment > 127)
 				{
-					throw parsing_error {"media type: tree: first character required to be alphanumeric"};
+					return fail(error::type_length);
 				}
 
-				if (value.back() != '.')
+				if (not first_character_valid)
 				{
-					throw parsing_error {"media type: tree: last character required to be '.'"};
+					return fail(error::type_first_character);
 				}
 
-				if (not is_modified_restricted_name({value.begin(), std::prev(value.end())}))
+				if (not segment_valid)
 				{
-					throw parsing_error {"media type: tree: containing non-valid characters"};
+					return fail(error::type_character);
 				}
-			}
-		}
 
-		/// @brief Validate subtype.
-		/// @param input Subtype in format 'subtype'
-		/// @exception media_type::parsing_error If string is empty.
-		/// @exception media_type::parsing_error If string is not less than 128 characters.
-		/// @exception media_type::parsing_error If first character is not alphanumeric.
-		/// @exception media_type::parsing_error If remainder of string is not alphanumeric or '!', '#', '$', '&', '-',
-		/// '^', '_', '.', '+'.
-		constexpr static void validate_subtype(const std::string_view value)
-		{
-			if (value.empty() or value.size() > 127)
-			{
-				throw parsing_error {"media type: subtype: lenght required to be [1..127] characters"};
+				after_slash = consumed + 1;
+				segment = 0;
+				return true;
 			}
 
-			if (not ascii::is_alphanumeric(value.front()))
+			/// @brief Validate registration tree as the first '.' after '/' is seen.
+			constexpr auto on_first_dot() noexcept -> bool
 			{
-				throw parsing_error {"media type: subtype: first character required to be alphanumeric"};
+				if (segment == 0)
+				{
+					return fail(error::missing_tree);
+				}
+
+				if (segment + 1 > 127)
+				{
+					return fail(error::tree_length);
+				}
+
+				if (not first_character_valid)
+				{
+					return fail(error::tree_first_character);
+				}
+
+				if (not segment_valid)
+				{
+					return fail(error::tree_character);
+				}
+
+				after_first_dot = segment + 1;
+				segment = 0;
+				last_plus = none;
+				first_invalid_subtype = none;
+				last_invalid_suffix = none;
+				return true;
 			}
 
-			if (not is_restricted_name(value))
+			/// @brief Consume character of tree, subtype or suffix, that is after '/' but not the first '.'.
+			constexpr void consume_subtype(const char character) noexcept
 			{
-				throw parsing_error {"media type: subtype: containing non-valid characters"};
+				if (segment == 0)
+				{
+					first_character_valid = ascii::is_alphanumeric(character);
+					segment_valid = true;
+				}
+
+				if (not after_first_dot)
+				{
+					/* Until a '.' is seen, the segment may yet turn out to be a tree. */
+					segment_valid = segment_valid and is_modified_restricted_name(character);
+				}
+
+				if (character == '+')
+				{
+					last_plus = segment;
+				}
+				else
+				{
+					if (last_plus != none and segment == last_plus + 1)
+					{
+						character_after_plus_valid = ascii::is_alphanumeric(character);
+					}
+
+					if (not is_modified_restricted_name(character))
+					{
+						last_invalid_suffix = segment;
+					}
+				}
+
+				if (first_invalid_subtype == none and not is_restricted_name(character))
+				{
+					first_invalid_subtype = segment;
+				}
+
+				++segment;
+				++consumed;
 			}
-		}
 
-		/// @brief Validate suffix.
-		/// @param input Suffix in format '+suffix'.
-		/// @exception media_type::parsing_error If string is less than 2 characters.
-		/// @exception media_type::parsing_error If string is not less than 128 characters.
-		/// @exception media_type::parsing_error If string does not begin with '+'.
-		/// @exception media_type::parsing_error If second character is not alphanumeric.
-		/// @exception media_type::parsing_error If remainder of string is not alphanumeric or '!', '#', '$', '&', '-',
-		/// '^', '_'.
-		constexpr static void validate_suffix(const std::string_view value)
-		{
-			if (value.size() < 2 or value.size() > 127)
+			/// @brief Blanks turned out to be inside the media type rather than before ';', consume them as any other character.
+			constexpr void flush_blanks() noexcept
 			{
-				throw parsing_error {"media type: suffix: lenght required to be [2..127] characters"};
+				for (; pending_blanks != 0; --pending_blanks)
+				{
+					consume_subtype(' ');
+				}
 			}
-			else
+
+		  public:
+			/// @brief Consume next character.
+			/// @param character Character to consume.
+			/// @return False if parsing has stopped, either at ';' or on error. Further characters are ignored.
+			constexpr auto consume(const char character) noexcept -> bool
 			{
-				if (value.front() != '+')
+				if (after_semicolon != none or failure)
 				{
-					throw parsing_error {"media type: suffix: first character required to be '+'"};
+					return false;
 				}
-				else
+
+				if (character == ';')
 				{
-					const std::string_view substring {std::next(value.begin()), value.end()};
+					after_semicolon = consumed + pending_blanks + 1;
+					return false;
+				}
 
-					if (not ascii::is_alphanumeric(substring.front()))
+				if (not after_slash)
+				{
+					if (character == '/')
+					{
+						if (not on_slash())
+						{
+							return false;
+						}
+					}
+					else
 					{
-						throw parsing_error {"media type: suffix: second character required to be alphanumeric"};
+						if (segment++ == 0)
+						{
+							first_character_valid = ascii::is_alphanumeric(character);
+						}
+
+						segment_valid = segment_valid and is_restricted_name(character);
 					}
 
-					if (not is_modified_restricted_name(substring))
+					++consumed;
+					return true;
+				}
+
+				if (ascii::is_blank(character))
+				{
+					++pending_blanks;
+					return true;
+				}
+
+				flush_blanks();
+
+				if (character == '.' and not after_first_dot)
+				{
+					if (not on_first_dot())
 					{
-						throw parsing_error {"media type: suffix: containing non-valid characters"};
+						return false;
 					}
+
+					++consumed;
+				}
+				else
+				{
+					consume_subtype(character);
 				}
+
+				return true;
 			}
-		}
 
-		constexpr void parse()
-		{
-			std::string_view view = value;
+			/// @brief Length of the type alone, the characters before the terminating ';' or the end less any blanks directly before it,
+			/// as taken by `type.substr(0, scanner.size())` in `media_type_view::try_parse`.
+			[[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return consumed; }
 
-			offset.after_slash = [&view]
+			/// @brief Offset of parameters, that is the first character after the terminating ';'.
+			/// @return Offset, or `std::string_view::npos` if no ';' was seen.
+			[[nodiscard]] constexpr auto parameters() const noexcept -> std::size_t { return after_semicolon; }
+
+			/// @brief Validate what remains after the last character.
+			/// @return Character offsets, or the first validation error encountered.
+			[[nodiscard]] constexpr auto finish() noexcept -> std::expected<character_offset, error>
 			{
-				if (const auto slash_offset = view.find('/'); slash_offset == std::string_view::npos)
+				if (failure)
 				{
-					throw parsing_error {"media type: parsing: missing delimiter '/' after type"};
+					return std::unexpected {*failure};
 				}
-				else
+
+				if (after_semicolon == none)
 				{
-					validate_type({view.begin(), slash_offset});
-					view.remove_prefix(slash_offset + 1);
-					return slash_offset + 1;
+					flush_blanks();
 				}
-			}();
 
-			offset.after_possible_first_dot = [&view]
-			{
-				if (const auto first_dot_offset = view.find('.'); first_dot_offset == 0)
+				if (not after_slash)
 				{
-					throw parsing_error {"media type: parsing: missing tree between delimiter '/' and '.'"};
+					return std::unexpected {error::missing_slash};
 				}
-				else if (first_dot_offset == std::string_view::npos)
+
+				const auto subtype_size = last_plus == none ? segment : last_plus;
+
+				if (subtype_size == 0 or subtype_size > 127)
 				{
-					return std::size_t {};
+					return std::unexpected {error::subtype_length};
 				}
-				else
+
+				if (not first_character_valid)
+				{
+					return std::unexpected {error::subtype_first_character};
+				}
+
+				if (first_invalid_subtype != none and first_invalid_subtype < subtype_size)
+				{
+					return std::unexpected {error::subtype_character};
+				}
+
+				if (last_plus != none)
 				{
-					validate_tree({view.begin(), first_dot_offset + 1});
-					view.remove_prefix(first_dot_offset + 1);
-					return first_dot_offset + 1;
+					if (const auto suffix_size = segment - last_plus; suffix_size < 2 or suffix_size > 127)
+					{
+						return std::unexpected {error::suffix_length};
+					}
+
+					if (not character_after_plus_valid)
+					{
+						return std::unexpected {error::suffix_second_character};
+					}
+
+					if (last_invalid_suffix != none and last_invalid_suffix > last_plus)
+					{
+						return std::unexpected {error::suffix_character};
+					}
 				}
-			}();
 
-			offset.possible_last_plus = [&view]
+				return character_offset {static_cast<unsigned char>(after_slash), static_cast<unsigned char>(after_first_dot),
+										 static_cast<unsigned char>(last_plus == none ? 0 : last_plus)};
+			}
+		};
+
+		/// @brief Parse parameters as defined by RFC 9110, visiting each one in order.
+		/// @brief Grammar is *( OWS ";" OWS [ token "=" ( token / quoted-string ) ] ), text starting after the first ';'.
+		/// @param text Parameters following the ';' that terminates the media type.
+		/// @param visitor Called with name, value and whether value was quoted. Returning false stops parsing early.
+		/// @return Nothing, or the first validation error encountered.
+		template<typename Visitor>
+		[[nodiscard]] constexpr static auto parse_parameters(const std::string_view text, Visitor&& visitor) noexcept
+			-> std::expected<void, error>
+		{
+			std::size_t index {};
+
+			auto skip_blanks = [&] noexcept
 			{
-				if (const auto last_plus_offset = view.rfind('+'); last_plus_offset == std::string_view::npos)
+				while (index < text.size() and ascii::is_blank(text[index]))
 				{
-					validate_subtype(view);
-					view = {};
-					return std::size_t {};
+					++index;
 				}
-				else
+			};
+
+			auto skip_token = [&] noexcept
+			{
+				const auto start = index;
+
+				while (index < text.size() and ascii::matches(text[index], ascii::character_class::token))
 				{
-					validate_subtype({view.begin(), last_plus_offset});
-					view.remove_prefix(last_plus_offset);
-					return last_plus_offset;
+					++index;
 				}
-			}();
 
-			if (not view.empty())
+				return text.substr(start, index - start);
+			};
+
+			while (true)
 			{
-				validate_suffix(view);
+				skip_blanks();
+
+				if (index == text.size())
+				{
+					return {};
+				}
+
+				/* Empty parameters are allowed, as in 'text/plain;;charset=utf-8'. */
+				if (text[index] != ';')
+				{
+					const auto name = skip_token();
+
+					if (name.empty())
+					{
+						return std::unexpected {error::parameter_name};
+					}
+
+					if (index == text.size() or text[index] != '=')
+					{
+						return std::unexpected {error::parameter_missing_equals};
+					}
+
+					++index;
+
+					std::string_view value {};
+					bool quoted {};
+
+					if (index < text.size() and text[index] == '"')
+					{
+						const auto start = ++index;
+
+						for (quoted = true; index < text.size() and text[index] != '"'; ++index)
+						{
+							if (text[index] == '\\')
+							{
+								++index;
+							}
+
+							/* qdtext and quoted-pair: horizontal tabulation, space, visible characters and obs-text. */
+							if (index == text.size() or (ascii::is_control(text[index]) and text[index] != '\t'))
+							{
+								return std::unexpected {error::parameter_value};
+							}
+						}
+
+						if (index == text.size())
+						{
+							return std::unexpected {error::parameter_unterminated_quote};
+						}
+
+						value = text.substr(start, index++ - start);
+					}
+					else if (value = skip_token(); value.empty() or (index < text.size() and text[index] != ';' and not ascii::is_blank(text[index])))
+					{
+						return std::unexpected {error::parameter_value};
+					}
+
+					if (not visitor(name, value, quoted))
+					{
+						return {};
+					}
+
+					skip_blanks();
+
+					if (index == text.size())
+					{
+						return {};
+					}
+
+					if (text[index] != ';')
+					{
+						return std::unexpected {error::parameter_missing_semicolon};
+					}
+				}
+
+				++index;
 			}
 		}
+	};
 
-		constexpr void prepare()
+	/// @brief Media type as defined by RFC 6838, with parameters as defined by RFC 9110.
+	/// @brief Parameters are not part of equality, compare them explicitly when they matter.
+	/// @brief Breaking change: parameters are validated with the type, so a malformed parameter rejects the whole media type where
+	/// everything after ';' used to be ignored. 'text/html;foo' fails with `error::parameter_missing_equals`.
+	/// @tparam Allocator Allocator of the characters and parameter offsets, as `std::pmr::polymorphic_allocator<char>` for arenas.
+	template<typename Allocator = std::allocator<char>>
+	class basic_media_type : public media_type_base
+	{
+		friend class media_type_view;
+		friend class accept_list;
+		friend class compact_media_type;
+		friend class media_type_parser;
+		template<typename>
+		friend class basic_media_type;
+
+	  public:
+		using allocator_type = Allocator;
+		using string_type = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+	  private:
+		using offset_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<parameter_offset>;
+
+		string_type value;
+
+		/// @brief By using numeric offsets instead of iterators the class is copy/move friendly.
+		character_offset offset {};
+
+		/// @brief Classification of `value`, computed once on construction. Fits in the padding after `offset`.
+		common_good::structured_suffix suffix_kind {};
+		common_good::top_level_type type_kind {};
+
+		/// @brief Hash of `value`, computed once on construction so hashing and unequal comparisons are cheap.
+		std::size_t hash_value {};
+
+		/// @brief Parameters in canonical form 'name=value;name="value"', names lowercase and no whitespace around delimiters.
+		string_type parameter_text;
+
+		/// @brief Offsets into `parameter_text`, at most two is stored without allocation as that covers 'charset' and 'boundary'.
+		small_vector<parameter_offset, 2, offset_allocator> parameter_offsets;
+
+		/// @brief Validate parameters and store them in canonical form.
+		/// @param text Parameters following the ';' that terminates the media type.
+		/// @return Nothing, or the first validation error encountered.
+		[[nodiscard]] constexpr auto store_parameters(const std::string_view text) -> std::expected<void, error>
 		{
-			/* As this class not currently supports parameters, the following lines ignores potentional parameters. */
-			if (const auto sentiel = std::ranges::find(value, ';'); sentiel != value.end())
+			auto visitor = [this](const std::string_view name, const std::string_view value, const bool quoted)
 			{
-				value = std::string {std::begin(value), sentiel};
-			}
+				if (not parameter_text.empty())
+				{
+					parameter_text.push_back(';');
+				}
+
+				const auto name_offset = parameter_text.size();
+
+				for (const auto character : name)
+				{
+					parameter_text.push_back(ascii::to_lowercase(character));
+				}
+
+				parameter_text.push_back('=');
+
+				if (quoted)
+				{
+					parameter_text.push_back('"');
+				}
 
-			std::ranges::transform(value, std::begin(value), ascii::to_lowercase);
+				const auto value_offset = parameter_text.size();
+				parameter_text.append(value);
+
+				if (quoted)
+				{
+					parameter_text.push_back('"');
+				}
+
+				parameter_offsets.push_back(parameter_offset {static_cast<std::uint32_t>(name_offset), static_cast<std::uint32_t>(name.size()),
+															  static_cast<std::uint32_t>(value_offset), static_cast<std::uint32_t>(value.size())});
+				return true;
+			};
+
+			return parse_parameters(text, visitor);
 		}
 
-	  public:
-		/// @brief Media type as defined by RFC 6838. NOTE: Currently no support for parameters.
-		/// @param type Media type in format 'type/tree.subtype+suffix'
-		/// @exception media_type::parsing_error If string fail to parse.
-		[[nodiscard]] constexpr media_type(std::string&& type) : value {std::move(type)}
+		/// @brief Compute hash and classification once `value` holds the final type.
+		constexpr void derive() noexcept
+		{
+			suffix_kind = classify_suffix(suffix_view());
+			type_kind = classify_top_level_type(type_view());
+			hash_value = hash_ignore_case(value);
+		}
+
+		/// @brief Lowercase and parse in a single pass, taking ownership of the string on success. Counted by `stats` when enabled.
+		/// @param value Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @return Media type using the allocator of value, or the first validation error encountered.
+		[[nodiscard]] constexpr static auto make(string_type&& value) -> std::expected<basic_media_type, error>
 		{
-			prepare();
-			parse();
+			return stats::measure([&]() -> std::expected<basic_media_type, error>
+			{
+				scanner scanner {};
+
+				for (auto& character : value)
+				{
+					if (not scanner.consume(ascii::to_lowercase(character)))
+					{
+						break;
+					}
+
+					character = ascii::to_lowercase(character);
+				}
+
+				if (const auto offset = scanner.finish(); offset)
+				{
+					basic_media_type result {string_type {value.get_allocator()}, *offset};
+
+					if (const auto parameters = scanner.parameters(); parameters != std::string_view::npos)
+					{
+						if (const auto stored = result.store_parameters(std::string_view {value}.substr(parameters)); not stored)
+						{
+							return std::unexpected {stored.error()};
+						}
+					}
+
+					value.resize(scanner.size());
+					result.value = std::move(value);
+					result.derive();
+					return result;
+				}
+				else
+				{
+					return std::unexpected {offset.error()};
+				}
+			});
 		}
 
-		/// @brief Media type as defined by RFC 6838. NOTE: Currently no support for parameters.
-		/// @param type Media type in format 'type/tree.subtype+suffix'
+		/// @brief Same as `make(string_type&&)` but throwing on failure, used by the public constructors.
 		/// @exception media_type::parsing_error If string fail to parse.
-		[[nodiscard]] constexpr media_type(const std::string& type) : value {type}
+		[[nodiscard]] constexpr static auto make_or_throw(string_type&& value) -> basic_media_type
 		{
-			prepare();
-			parse();
+			if (auto result = make(std::move(value)); result)
+			{
+				return std::move(*result);
+			}
+			else
+			{
+				throw parsing_error {result.error()};
+			}
 		}
 
-		/// @brief Media type as defined by RFC 6838. NOTE: Currently no support for parameters.
-		/// @param type Media type in format 'type/tree.subtype+suffix'
+		/// @brief Construct from already prepared and parsed parts, every member using the allocator of value.
+		[[nodiscard]] constexpr basic_media_type(string_type&& value, const character_offset offset) noexcept :
+			value {std::move(value)}, offset {offset}, parameter_text {this->value.get_allocator()},
+			parameter_offsets {offset_allocator {this->value.get_allocator()}}
+		{ }
+
+	  public:
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value', its allocator is used for all storage.
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr basic_media_type(string_type&& type) : basic_media_type {make_or_throw(std::move(type))} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value', its allocator is used for all storage.
 		/// @exception media_type::parsing_error If string fail to parse.
-		[[nodiscard]] constexpr media_type(const std::string_view type) : media_type {std::string {type}} { }
+		[[nodiscard]] constexpr basic_media_type(const string_type& type) :
+			basic_media_type {make_or_throw(string_type {type, type.get_allocator()})}
+		{ }
 
-		/// @brief Media type as defined by RFC 6838. NOTE: Currently no support for parameters.
-		/// @param type Media type in format 'type/tree.subtype+suffix'
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @param allocator Allocator used for all storage.
 		/// @exception media_type::parsing_error If string fail to parse.
-		[[nodiscard]] constexpr media_type(const char* const type) : media_type {std::string {type}} { }
+		[[nodiscard]] constexpr basic_media_type(const std::string_view type, const Allocator& allocator = Allocator {}) :
+			basic_media_type {make_or_throw(string_type {type, allocator})}
+		{ }
 
-		[[nodiscard]] constexpr auto operator==(const media_type& other) const noexcept -> bool { return value == other.value; };
-		[[nodiscard]] constexpr auto operator==(const std::string& other) const noexcept -> bool { return value == other; };
-		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool { return value == other; };
-		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool { return value == other; };
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @param allocator Allocator used for all storage.
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr basic_media_type(const char* const type, const Allocator& allocator = Allocator {}) :
+			basic_media_type {make_or_throw(string_type {type, allocator})}
+		{ }
 
-		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
-		[[nodiscard]] constexpr auto string() && noexcept -> std::string { return std::move(value); }
+		/// @brief Copy an already validated view into an owning, lowercase media type. Does not parse again.
+		/// @param view Media type view. Defined in 'media_type_view.hpp'.
+		/// @param allocator Allocator used for all storage.
+		[[nodiscard]] constexpr explicit basic_media_type(const media_type_view& view, const Allocator& allocator = Allocator {});
 
-		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
-		[[nodiscard]] constexpr auto string() const& -> const std::string& { return value; }
+		/// @brief Copy using another allocator, as needed by allocator-aware containers. Does not parse again.
+		[[nodiscard]] constexpr basic_media_type(const basic_media_type& other, const Allocator& allocator) :
+			value {other.value, allocator}, offset {other.offset}, suffix_kind {other.suffix_kind}, type_kind {other.type_kind},
+			hash_value {other.hash_value}, parameter_text {other.parameter_text, allocator}, parameter_offsets {other.parameter_offsets, offset_allocator {allocator}}
+		{ }
 
-		/// @brief Get top-level type.
-		[[nodiscard]] constexpr auto type() const -> std::string { return value.substr(0, offset.after_slash - 1); }
+		/// @brief Move using another allocator, copying if the allocators differ. Does not parse again.
+		[[nodiscard]] constexpr basic_media_type(basic_media_type&& other, const Allocator& allocator) :
+			value {std::move(other.value), allocator}, offset {other.offset}, suffix_kind {other.suffix_kind}, type_kind {other.type_kind},
+			hash_value {other.hash_value}, parameter_text {std::move(other.parameter_text), allocator},
+			parameter_offsets {std::move(other.parameter_offsets), offset_allocator {allocator}}
+		{ }
 
-		/// @brief Get registration tree.
-		[[nodiscard]] constexpr auto tree() const -> std::string
+		/// @brief Copy from a media type using another allocator type, as between the heap and an arena. Does not parse again.
+		template<typename OtherAllocator>
+		[[nodiscard]] constexpr explicit basic_media_type(const basic_media_type<OtherAllocator>& other, const Allocator& allocator = Allocator {}) :
+			value {std::string_view {other.value}, allocator}, offset {other.offset}, suffix_kind {other.suffix_kind}, type_kind {other.type_kind},
+			hash_value {other.hash_value}, parameter_text {std::string_view {other.parameter_text}, allocator},
+			parameter_offsets {offset_allocator {allocator}}
 		{
-			if (offset.after_possible_first_dot)
-			{
-				return value.substr(offset.after_slash, offset.after_possible_first_dot);
-			}
-			else
+			for (const auto parameter : other.parameter_offsets)
 			{
-				return {};
+				parameter_offsets.push_back(parameter);
 			}
 		}
 
-		/// @brief Get subtype.
-		[[nodiscard]] constexpr auto subtype() const -> std::string
+		[[nodiscard]] constexpr basic_media_type(const basic_media_type&) = default;
+		[[nodiscard]] constexpr basic_media_type(basic_media_type&&) noexcept = default;
+		constexpr auto operator=(const basic_media_type&) -> basic_media_type& = default;
+		constexpr auto operator=(basic_media_type&&) noexcept -> basic_media_type& = default;
+		constexpr ~basic_media_type() = default;
+
+		/// @brief Non-throwing alternative to the constructors, for input that is expected to be malformed now and then.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		/// @param allocator Allocator used for all storage.
+		/// @return Media type, or the reason the string fail to parse, a malformed parameter included.
+		[[nodiscard]] constexpr static auto try_parse(const std::string_view type, const Allocator& allocator = Allocator {})
+			-> std::expected<basic_media_type, error>
+		{ return make(string_type {type, allocator}); }
+
+		/// @brief Get allocator used for all storage.
+		[[nodiscard]] constexpr auto get_allocator() const noexcept -> Allocator { return value.get_allocator(); }
+
+		/// @brief Compares the stored hashes first, so unequal types rarely compare any characters. Allocators are not compared.
+		template<typename OtherAllocator>
+		[[nodiscard]] constexpr auto operator==(const basic_media_type<OtherAllocator>& other) const noexcept -> bool
+		{ return hash_value == other.hash_value and std::string_view {value} == std::string_view {other.value}; };
+
+		/// @brief Compares in ascii case-insensitive manner, so other need not be lowercased first.
+		[[nodiscard]] constexpr auto operator==(const string_type& other) const noexcept -> bool
+		{ return ascii::equals_ignore_case(value, other); };
+		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool
+		{ return ascii::equals_ignore_case(value, other); };
+		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool
+		{ return ascii::equals_ignore_case(value, other); };
+
+		/// @brief Orders lexicographically by component using the stored offsets: top-level type, tree, subtype and suffix.
+		/// @brief Parameters are not considered, consistent with equality. Allocators are not compared.
+		template<typename OtherAllocator>
+		[[nodiscard]] constexpr auto operator<=>(const basic_media_type<OtherAllocator>& other) const noexcept -> std::weak_ordering
+		{ return compare_components(value, offset, other.value, other.offset); };
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
+		[[nodiscard]] constexpr auto string() && noexcept -> string_type { return std::move(value); }
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
+		[[nodiscard]] constexpr auto string() const& -> const string_type& { return value; }
+
+		/// @brief Get top-level type, using the same allocator.
+		[[nodiscard]] constexpr auto type() const -> string_type { return string_type {type_view(), value.get_allocator()}; }
+
+		/// @brief Get registration tree, using the same allocator.
+		[[nodiscard]] constexpr auto tree() const -> string_type { return string_type {tree_view(), value.get_allocator()}; }
+
+		/// @brief Get subtype, using the same allocator.
+		[[nodiscard]] constexpr auto subtype() const -> string_type { return string_type {subtype_view(), value.get_allocator()}; }
+
+		/// @brief Get structured type name suffix, using the same allocator.
+		[[nodiscard]] constexpr auto suffix() const -> string_type { return string_type {suffix_view(), value.get_allocator()}; }
+
+		/// @brief Get top-level type without copying.
+		/// @brief The view points into this object and is invalidated when it is destroyed, assigned to or moved from.
+		[[nodiscard]] constexpr auto type_view() const& noexcept -> std::string_view
+		{ return std::string_view {value}.substr(0, offset.after_slash - 1); }
+
+		/// @brief Get registration tree without copying.
+		/// @brief The view points into this object and is invalidated when it is destroyed, assigned to or moved from.
+		[[nodiscard]] constexpr auto tree_view() const& noexcept -> std::string_view
+		{ return std::string_view {value}.substr(offset.after_slash, offset.after_possible_first_dot); }
+
+		/// @brief Get subtype without copying.
+		/// @brief The view points into this object and is invalidated when it is destroyed, assigned to or moved from.
+		[[nodiscard]] constexpr auto subtype_view() const& noexcept -> std::string_view
 		{
 			const auto start = static_cast<std::size_t>(offset.after_slash) + static_cast<std::size_t>(offset.after_possible_first_dot);
 
 			if (offset.possible_last_plus)
 			{
-				return value.substr(start, offset.possible_last_plus);
+				return std::string_view {value}.substr(start, offset.possible_last_plus);
 			}
 			else
 			{
-				return value.substr(start);
+				return std::string_view {value}.substr(start);
 			}
 		}
 
-		/// @brief Get structured type name suffix.
-		[[nodiscard]] constexpr auto suffix() const -> std::string
+		/// @brief Get structured type name suffix without copying.
+		/// @brief The view points into this object and is invalidated when it is destroyed, assigned to or moved from.
+		[[nodiscard]] constexpr auto suffix_view() const& noexcept -> std::string_view
 		{
 			if (offset.possible_last_plus)
 			{
 				const auto start = static_cast<std::size_t>(offset.after_slash) + static_cast<std::size_t>(offset.after_possible_first_dot)
 								   + static_cast<std::size_t>(offset.possible_last_plus);
-				return value.substr(start);
+				return std::string_view {value}.substr(start);
 			}
 			else
 			{
@@ -346,31 +1016,229 @@ namespace common_good
 			}
 		}
 
+		/// @brief Views of a temporary would dangle, use the copying accessors instead.
+		auto type_view() && -> std::string_view = delete;
+		auto tree_view() && -> std::string_view = delete;
+		auto subtype_view() && -> std::string_view = delete;
+		auto suffix_view() && -> std::string_view = delete;
+
+		/// @brief Get value of parameter, without copying.
+		/// @brief The view points into this object and is invalidated when it is destroyed, assigned to or moved from.
+		/// @param name Parameter name, compared case-insensitively.
+		/// @return Value of first parameter with name, or nothing if there is none.
+		[[nodiscard]] constexpr auto parameter(const std::string_view name) const& noexcept -> std::optional<std::string_view>
+		{
+			for (const auto& parameter : parameter_offsets)
+			{
+				if (equals_ignore_case(std::string_view {parameter_text}.substr(parameter.name, parameter.name_size), name))
+				{
+					return std::string_view {parameter_text}.substr(parameter.value, parameter.value_size);
+				}
+			}
+
+			return std::nullopt;
+		}
+
+		/// @brief Get all parameters in order, without copying.
+		/// @brief The views point into this object and are invalidated when it is destroyed, assigned to or moved from.
+		[[nodiscard]] constexpr auto parameters() const& -> parameter_list
+		{
+			parameter_list list {};
+
+			for (const auto& parameter : parameter_offsets)
+			{
+				list.push_back({std::string_view {parameter_text}.substr(parameter.name, parameter.name_size),
+								std::string_view {parameter_text}.substr(parameter.value, parameter.value_size)});
+			}
+
+			return list;
+		}
+
+		/// @brief Get parameters serialised in canonical form 'name=value;name="value"', without the leading ';'.
+		[[nodiscard]] constexpr auto parameters_string() const& noexcept -> const string_type& { return parameter_text; }
+
+		auto parameter(std::string_view) && -> std::optional<std::string_view> = delete;
+		auto parameters() && -> parameter_list = delete;
+
 		/// @brief Check if media type is in standards tree.
 		/// @return True if media type is in standards tree.
 		[[nodiscard]] constexpr auto in_standards_tree() const noexcept -> bool { return not offset.after_possible_first_dot; }
 
-		class parsing_error : public std::invalid_argument
+		/// @brief Get structured syntax suffix, for dispatch without comparing strings. Computed once on construction.
+		[[nodiscard]] constexpr auto structured_suffix() const noexcept -> common_good::structured_suffix { return suffix_kind; }
+
+		/// @brief Get top-level type, for dispatch without comparing strings. Computed once on construction.
+		[[nodiscard]] constexpr auto top_level_type() const noexcept -> common_good::top_level_type { return type_kind; }
+
+		/// @brief Get hash of type, parameters not included. Computed once on construction.
+		[[nodiscard]] constexpr auto hash() const noexcept -> std::size_t { return hash_value; }
+
+		/// @brief Get preferred file extension, parameters not considered.
+		/// @return Extension without leading '.', or nothing if there is none. Defined in 'media_type_extension.hpp'.
+		[[nodiscard]] constexpr auto preferred_extension() const noexcept -> std::optional<std::string_view>;
+	};
+
+	/// @brief Media type using the global allocator.
+	using media_type = basic_media_type<>;
+
+	namespace pmr
+	{
+		/// @brief Media type using a memory resource, such as a per-request `std::pmr::monotonic_buffer_resource` freed all at once.
+		using media_type = basic_media_type<std::pmr::polymorphic_allocator<char>>;
+	}
+
+	/// @brief Base of the `std::formatter` of every media type class, writing straight from the stored characters into the output.
+	/// @brief Spec is '[component][:string-spec]', component being 't' top-level type, 'r' registration tree, 'u' subtype,
+	/// 'y' suffix, or 'w' for the media type followed by ';' and its parameters in canonical form. Without component the spec
+	/// is the standard string spec, so '{:s}' and '{:>20}' write 'type/tree.subtype+suffix'. The string spec, nested widths
+	/// included, is parsed by `std::formatter<std::string_view>` against the caller's context; 'w' takes none.
+	class media_type_formatter
+	{
+		std::formatter<std::string_view> component_formatter;
+		char component {};
+
+		[[nodiscard]] constexpr static auto is_component(const char character) noexcept -> bool
+		{ return character == 't' or character == 'r' or character == 'u' or character == 'y' or character == 'w'; }
+
+	  protected:
+		/// @brief Characters of the formatted object, all viewing its own storage.
+		struct components
 		{
-		  public:
-			[[nodiscard]] explicit parsing_error(const std::string& message) noexcept : std::invalid_argument {message} { };
-			[[nodiscard]] explicit parsing_error(const char* const message) noexcept : std::invalid_argument {message} { };
+			std::string_view string;
+			std::string_view type;
+			std::string_view tree;
+			std::string_view subtype;
+			std::string_view suffix;
+
+			/// @brief Parameters without the leading ';'.
+			std::string_view parameters;
+
+			/// @brief Parameters are already in canonical form, and copied as is.
+			bool canonical;
 		};
+
+		template<typename Context>
+		constexpr auto write(const components& parts, Context& context) const -> typename Context::iterator
+		{
+			switch (component)
+			{
+				case 't': return component_formatter.format(parts.type, context);
+				case 'r': return component_formatter.format(parts.tree, context);
+				case 'u': return component_formatter.format(parts.subtype, context);
+				case 'y': return component_formatter.format(parts.suffix, context);
+				case 'w': break;
+				default: return component_formatter.format(parts.string, context);
+			}
+
+			auto out = std::ranges::copy(parts.string, context.out()).out;
+
+			if (parts.canonical)
+			{
+				if (not parts.parameters.empty())
+				{
+					*out++ = ';';
+					out = std::ranges::copy(parts.parameters, out).out;
+				}
+
+				return out;
+			}
+
+			auto visitor = [&](const std::string_view name, const std::string_view value, const bool quoted)
+			{
+				*out++ = ';';
+				out = std::ranges::transform(name, out, [](const char character) noexcept { return ascii::to_lowercase(character); }).out;
+				*out++ = '=';
+
+				if (quoted)
+				{
+					*out++ = '"';
+				}
+
+				out = std::ranges::copy(value, out).out;
+
+				if (quoted)
+				{
+					*out++ = '"';
+				}
+
+				return true;
+			};
+
+			/* Every class formatted has already validated its parameters. */
+			static_cast<void>(media_type_base::parse_parameters(parts.parameters, visitor));
+			return out;
+		}
+
+	  public:
+		constexpr auto parse(std::format_parse_context& context) -> std::format_parse_context::iterator
+		{
+			auto first = context.begin();
+
+			/* A component letter stands alone or before ':', anything else is left to the string formatter. */
+			if (first == context.end() or not is_component(*first))
+			{
+				return component_formatter.parse(context);
+			}
+
+			if (const auto next = first + 1; next != context.end() and *next != '}' and *next != ':')
+			{
+				return component_formatter.parse(context);
+			}
+
+			component = *first++;
+
+			if (first != context.end() and *first == ':')
+			{
+				if (component == 'w')
+				{
+					throw std::format_error {"media type: format: component 'w' takes no fill, alignment nor width"};
+				}
+
+				++first;
+			}
+
+			context.advance_to(first);
+			return component_formatter.parse(context);
+		}
 	};
 
 	inline namespace literals
 	{
-		/// @brief Media type as defined by RFC 6838. NOTE: Currently no support for parameters.
-		/// @param string Media type in format 'type/tree.subtype+suffix'
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param string Media type in format 'type/tree.subtype+suffix;name=value'
 		/// @exception media_type::parsing_error If string fail to parse.
 		[[nodiscard]] constexpr auto operator""_media_type(const char* const string, const std::size_t lenght)
 		{ return common_good::media_type {std::string {string, lenght}}; }
 	}
 }
 
-template<>
-struct std::formatter<common_good::media_type> : std::formatter<std::string>
+/// @brief Transparent, so unordered containers with `std::equal_to<>` can be searched by string or view without constructing a media type.
+template<typename Allocator>
+struct std::hash<common_good::basic_media_type<Allocator>>
 {
-	constexpr auto format(const common_good::media_type& media_type, auto&& context) const
-	{ return std::formatter<std::string>::format(media_type.string(), context); }
-};
\ No newline at end of file
+	using is_transparent = void;
+
+	[[nodiscard]] constexpr auto operator()(const common_good::basic_media_type<Allocator>& type) const noexcept -> std::size_t
+	{ return type.hash(); }
+
+	[[nodiscard]] constexpr auto operator()(const std::string_view type) const noexcept -> std::size_t
+	{ return common_good::media_type_base::hash_ignore_case(type); }
+
+	/// @brief Template as `media_type_view` is incomplete here.
+	template<std::same_as<common_good::media_type_view> View>
+	[[nodiscard]] constexpr auto operator()(const View& type) const noexcept -> std::size_t
+	{ return common_good::media_type_base::hash_ignore_case(type.string()); }
+};
+
+template<typename Allocator>
+struct std::formatter<common_good::basic_media_type<Allocator>> : common_good::media_type_formatter
+{
+	constexpr auto format(const common_good::basic_media_type<Allocator>& media_type, auto&& context) const
+	{
+		return write({media_type.string(), media_type.type_view(), media_type.tree_view(), media_type.subtype_view(), media_type.suffix_view(),
+					  media_type.parameters_string(), true},
+					 context);
+	}
+};
+/* `media_type_view`, `from_extension()` and `preferred_extension()` are declared above, so their definitions follow here. */
+#include "media_type_view.hpp"
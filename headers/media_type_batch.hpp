@@ -0,0 +1,123 @@
+#pragma once
+
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Caller-owned columns receiving the results of `validate_batch`, one element per input row in each.
+	/// @brief Struct of arrays, so results are written straight into columnar storage without an intermediate row type.
+	struct media_type_columns
+	{
+		/// @brief Status of a valid row, any other status is a `media_type::error`.
+		static constexpr std::uint8_t valid {0xFF};
+
+		/// @brief `valid`, or the first validation error encountered cast from `media_type::error`.
+		std::span<std::uint8_t> status;
+
+		/// @brief Characters of type before the parameters, as `media_type_view::string()`. Zero if row is invalid.
+		std::span<std::uint16_t> type_size;
+
+		/// @brief Offset of parameters, the first character after ';'. Row size if row has no parameters or is invalid.
+		std::span<std::uint32_t> parameters;
+
+		/// @brief Offset of the character after '/'.
+		std::span<unsigned char> after_slash;
+
+		/// @brief Offset of the character after a tree's '.' relative to `after_slash`, zero if no tree.
+		std::span<unsigned char> after_first_dot;
+
+		/// @brief Offset of the suffix's '+' relative to `after_slash`, zero if no suffix.
+		std::span<unsigned char> last_plus;
+
+		/// @brief Get error of row.
+		/// @param row Index of row.
+		/// @return Error, or nothing if row is valid.
+		[[nodiscard]] constexpr auto error(const std::size_t row) const noexcept -> std::optional<media_type::error>
+		{
+			if (status[row] == valid)
+			{
+				return std::nullopt;
+			}
+
+			return static_cast<media_type::error>(status[row]);
+		}
+
+		/// @brief Smallest number of rows any column can hold.
+		[[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+		{
+			return std::min({status.size(), type_size.size(), parameters.size(), after_slash.size(), after_first_dot.size(),
+							 last_plus.size()});
+		}
+
+		/// @brief Validate a single row, writing its results into every column.
+		/// @param row Index of row.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value'
+		constexpr void store(const std::size_t row, const std::string_view type) const noexcept
+		{
+			if (const auto result = media_type_view::try_parse(type); result)
+			{
+				status[row] = valid;
+				type_size[row] = static_cast<std::uint16_t>(result->value.size());
+				parameters[row] = static_cast<std::uint32_t>(type.size() - result->parameter_text.size());
+				after_slash[row] = result->offset.after_slash;
+				after_first_dot[row] = result->offset.after_possible_first_dot;
+				last_plus[row] = result->offset.possible_last_plus;
+			}
+			else
+			{
+				status[row] = static_cast<std::uint8_t>(result.error());
+				type_size[row] = 0;
+				parameters[row] = static_cast<std::uint32_t>(type.size());
+				after_slash[row] = 0;
+				after_first_dot[row] = 0;
+				last_plus[row] = 0;
+			}
+		}
+	};
+
+	/// @brief Validate many media types at once, without allocation or exceptions per row.
+	/// @param input Rows of media types in format 'type/tree.subtype+suffix;name=value'
+	/// @param output Columns holding at least as many rows as input.
+	/// @exception std::length_error If any column is shorter than input.
+	constexpr void validate_batch(const std::span<const std::string_view> input, const media_type_columns& output)
+	{
+		if (output.size() < input.size())
+		{
+			throw std::length_error {"media type batch: columns shorter than input"};
+		}
+
+		for (std::size_t row {}; row < input.size(); ++row)
+		{
+			output.store(row, input[row]);
+		}
+	}
+
+	/// @brief Validate many media types at once using execution policy, such as `std::execution::par_unseq` across cores.
+	/// @brief Rows are independent and write disjoint elements, so any policy is safe. `<execution>` is left to the caller, as
+	/// libstdc++ then needs TBB linked for every policy but `seq`.
+	/// @param policy Standard execution policy.
+	/// @param input Rows of media types in format 'type/tree.subtype+suffix;name=value'
+	/// @param output Columns holding at least as many rows as input.
+	/// @exception std::length_error If any column is shorter than input.
+	template<typename Policy>
+	void validate_batch(Policy&& policy, const std::span<const std::string_view> input, const media_type_columns& output)
+	{
+		if (output.size() < input.size())
+		{
+			throw std::length_error {"media type batch: columns shorter than input"};
+		}
+
+		std::for_each(std::forward<Policy>(policy), input.begin(), input.end(),
+					  [&](const std::string_view& type) noexcept { output.store(static_cast<std::size_t>(&type - input.data()), type); });
+	}
+}
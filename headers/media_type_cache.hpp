@@ -0,0 +1,254 @@
+#pragma once
+
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief Bounded cache of parse results keyed by the raw header bytes, for traffic dominated by a few distinct header strings.
+	/// @brief A hit returns a view over the caller's own header without validating it again, failures included, so known-bad input is
+	/// not validated again either. Lookups take no lock and write nothing shared except a reference bit cleared by eviction, so
+	/// many threads may hit the same entry without contending.
+	/// @brief Entries live in sets of `ways` slots, evicted by CLOCK within the set. Each slot is a sequence lock: a reader that
+	/// races with a writer sees a miss and parses as usual.
+	class media_type_cache
+	{
+	  public:
+		/// @brief Longest header cached, longer headers are parsed every time.
+		static constexpr std::size_t key_capacity {128};
+
+		/// @brief Slots per set.
+		static constexpr std::size_t ways {4};
+
+	  private:
+		static constexpr std::size_t key_words {key_capacity / sizeof(std::uint64_t)};
+
+		/// @brief Cached result packed into a single word, so it is read in one load.
+		/// @brief Bit 63 marks a used slot, then from the low byte: key size, status, type size, parameters offset and the three
+		/// character offsets. Every value is at most `key_capacity`, so each fit a byte.
+		static constexpr std::uint64_t used {std::uint64_t {1} << 63};
+
+		/// @brief Status of a successful parse, any other status is a `media_type::error`.
+		static constexpr std::uint8_t valid {0xFF};
+
+		struct alignas(64) slot
+		{
+			/// @brief Odd while being written.
+			std::atomic<std::uint32_t> version {};
+
+			/// @brief Set on hit and cleared as the CLOCK hand passes.
+			std::atomic<bool> referenced {};
+
+			std::atomic<std::uint64_t> entry {};
+			std::array<std::atomic<std::uint64_t>, key_words> key {};
+		};
+
+		std::size_t set_mask;
+		std::unique_ptr<slot[]> slots;
+		std::unique_ptr<std::atomic<std::uint8_t>[]> hands;
+
+		/// @brief Header as words, padded with zero so equal headers compare equal word by word.
+		[[nodiscard]] static auto words(const std::string_view header) noexcept -> std::array<std::uint64_t, key_words>
+		{
+			std::array<std::uint64_t, key_words> result {};
+
+			if (not header.empty())
+			{
+				std::memcpy(result.data(), header.data(), header.size());
+			}
+
+			return result;
+		}
+
+		[[nodiscard]] static constexpr auto byte(const std::uint64_t entry, const unsigned index) noexcept -> std::uint8_t
+		{ return static_cast<std::uint8_t>(entry >> (index * 8)); }
+
+		[[nodiscard]] static auto pack(const std::string_view header, const std::expected<media_type_view, media_type::error>& result) noexcept
+			-> std::uint64_t
+		{
+			auto entry = used | header.size();
+
+			if (not result)
+			{
+				return entry | std::uint64_t {static_cast<std::uint8_t>(result.error())} << 8;
+			}
+
+			const auto parameters = header.size() - result->parameter_text.size();
+			const std::array<std::uint64_t, 6> fields {valid,
+													   result->value.size(),
+													   parameters,
+													   result->offset.after_slash,
+													   result->offset.after_possible_first_dot,
+													   result->offset.possible_last_plus};
+
+			for (std::size_t index {}; index < fields.size(); ++index)
+			{
+				entry |= fields[index] << ((index + 1) * 8);
+			}
+
+			return entry;
+		}
+
+		[[nodiscard]] static auto unpack(const std::string_view header, const std::uint64_t entry) noexcept
+			-> std::expected<media_type_view, media_type::error>
+		{
+			if (const auto status = byte(entry, 1); status != valid)
+			{
+				return std::unexpected {static_cast<media_type::error>(status)};
+			}
+
+			return media_type_view {header.substr(0, byte(entry, 2)),
+									header.substr(byte(entry, 3)),
+									media_type::character_offset {byte(entry, 4), byte(entry, 5), byte(entry, 6)}};
+		}
+
+		/// @brief Read slot under its sequence lock.
+		/// @return Entry if slot holds header and was not written meanwhile, otherwise zero.
+		[[nodiscard]] static auto read(const slot& slot, const std::size_t size, const std::array<std::uint64_t, key_words>& key) noexcept
+			-> std::uint64_t
+		{
+			const auto version = slot.version.load(std::memory_order_acquire);
+
+			if (version & 1)
+			{
+				return 0;
+			}
+
+			const auto entry = slot.entry.load(std::memory_order_relaxed);
+			auto same = (entry & used) and byte(entry, 0) == size;
+
+			for (std::size_t index {}; same and index < key_words; ++index)
+			{
+				same = slot.key[index].load(std::memory_order_relaxed) == key[index];
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return same and slot.version.load(std::memory_order_relaxed) == version ? entry : 0;
+		}
+
+		/// @brief Store entry in set, replacing the first slot the CLOCK hand finds unreferenced. Gives up if another thread is
+		/// writing that slot, as the entry will simply be cached on a later miss.
+		void write(const std::size_t set, const std::uint64_t entry, const std::array<std::uint64_t, key_words>& key) noexcept
+		{
+			const auto first = set * ways;
+			auto hand = hands[set].load(std::memory_order_relaxed);
+
+			/* A full sweep clears every bit, so the second lap always finds a victim. */
+			for (std::size_t step {}; step < ways * 2; ++step, hand = static_cast<std::uint8_t>((hand + 1) % ways))
+			{
+				if (slots[first + hand].referenced.exchange(false, std::memory_order_relaxed))
+				{
+					continue;
+				}
+
+				break;
+			}
+
+			hands[set].store(static_cast<std::uint8_t>((hand + 1) % ways), std::memory_order_relaxed);
+
+			auto& slot = slots[first + hand];
+			auto version = slot.version.load(std::memory_order_relaxed);
+
+			if ((version & 1) or not slot.version.compare_exchange_strong(version, version + 1, std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			std::atomic_thread_fence(std::memory_order_release);
+
+			slot.entry.store(entry, std::memory_order_relaxed);
+
+			for (std::size_t index {}; index < key_words; ++index)
+			{
+				slot.key[index].store(key[index], std::memory_order_relaxed);
+			}
+
+			slot.referenced.store(false, std::memory_order_relaxed);
+			slot.version.store(version + 2, std::memory_order_release);
+		}
+
+	  public:
+		/// @brief Empty cache.
+		/// @param capacity Number of entries, rounded up to a power of two number of sets.
+		[[nodiscard]] explicit media_type_cache(const std::size_t capacity = 256) :
+			set_mask {std::bit_ceil(std::max<std::size_t>(capacity / ways, 1)) - 1},
+			slots {std::make_unique<slot[]>((set_mask + 1) * ways)},
+			hands {std::make_unique<std::atomic<std::uint8_t>[]>(set_mask + 1)}
+		{ }
+
+		media_type_cache(const media_type_cache&) = delete;
+		auto operator=(const media_type_cache&) -> media_type_cache& = delete;
+
+		/// @brief Same as `media_type_view::try_parse`, answered from the cache when header has been seen before.
+		/// @param header Media type in format 'type/tree.subtype+suffix;name=value', must outlive the view.
+		/// @return View over header, or the reason it fail to parse.
+		[[nodiscard]] auto try_parse(const std::string_view header) noexcept -> std::expected<media_type_view, media_type::error>
+		{
+			if (header.size() > key_capacity)
+			{
+				return media_type_view::try_parse(header);
+			}
+
+			const auto key = words(header);
+			const auto set = media_type::hash_ignore_case(header) & set_mask;
+
+			for (std::size_t way {}; way < ways; ++way)
+			{
+				auto& slot = slots[set * ways + way];
+
+				if (const auto entry = read(slot, header.size(), key))
+				{
+					/* Only written when clear, so hot entries do not bounce their cache line between threads. */
+					if (not slot.referenced.load(std::memory_order_relaxed))
+					{
+						slot.referenced.store(true, std::memory_order_relaxed);
+					}
+
+					return unpack(header, entry);
+				}
+			}
+
+			const auto result = media_type_view::try_parse(header);
+			write(set, pack(header, result), key);
+			return result;
+		}
+
+		/// @brief Test if the result for header is cached, without marking it referenced.
+		/// @param header Media type as passed to `try_parse`.
+		/// @return True if a `try_parse` of header would be answered from the cache, unless evicted meanwhile.
+		[[nodiscard]] auto contains(const std::string_view header) const noexcept -> bool
+		{
+			if (header.size() > key_capacity)
+			{
+				return false;
+			}
+
+			const auto key = words(header);
+			const auto set = media_type::hash_ignore_case(header) & set_mask;
+
+			for (std::size_t way {}; way < ways; ++way)
+			{
+				if (read(slots[set * ways + way], header.size(), key))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/// @brief Get number of entries the cache holds at most.
+		[[nodiscard]] auto capacity() const noexcept -> std::size_t { return (set_mask + 1) * ways; }
+	};
+}
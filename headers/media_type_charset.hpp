@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+#include "static_media_type.hpp"
+#include "utf8.hpp"
+
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief Character encoding of a text body, as far as bodies can be validated against it.
+	enum class charset : unsigned char
+	{
+		/// @brief Not a text type, no charset given, or a charset not validated.
+		unknown,
+
+		us_ascii,
+		utf_8,
+	};
+
+	/// @brief Get charset of a 'text/*' media type by its 'charset' parameter, accepting the names registered with IANA.
+	/// @param type Media type, parameters included.
+	/// @return Charset, or unknown if type is not text or names no charset that is validated.
+	[[nodiscard]] constexpr auto charset_of(const media_type_view type) noexcept -> charset
+	{
+		constexpr std::array<std::string_view, 11> us_ascii_names {"us-ascii", "ascii", "iso646-us", "ansi_x3.4-1968", "ansi_x3.4-1986",
+																   "iso_646.irv:1991", "iso-ir-6", "us", "ibm367", "cp367", "csascii"};
+		constexpr std::array<std::string_view, 2> utf_8_names {"utf-8", "csutf8"};
+
+		if (type.top_level_type() != top_level_type::text)
+		{
+			return charset::unknown;
+		}
+
+		const auto name = type.parameter("charset");
+
+		if (not name)
+		{
+			return charset::unknown;
+		}
+
+		for (const auto candidate : us_ascii_names)
+		{
+			if (ascii::equals_ignore_case(*name, candidate))
+			{
+				return charset::us_ascii;
+			}
+		}
+
+		for (const auto candidate : utf_8_names)
+		{
+			if (ascii::equals_ignore_case(*name, candidate))
+			{
+				return charset::utf_8;
+			}
+		}
+
+		return charset::unknown;
+	}
+
+	/// @brief Validate body against charset. Vectorised where supported.
+	/// @param encoding Charset of body.
+	/// @param body Bytes of body.
+	/// @return True if body is valid in charset, or nothing if charset is not validated.
+	[[nodiscard]] constexpr auto validate_body(const charset encoding, const std::string_view body) noexcept -> std::optional<bool>
+	{
+		switch (encoding)
+		{
+			case charset::us_ascii: return ascii::all_ascii(body);
+			case charset::utf_8: return utf8::is_valid(body);
+			case charset::unknown: return std::nullopt;
+		}
+
+		return std::nullopt;
+	}
+
+	/// @brief Validate body against the charset of its media type, before caching it for instance. Vectorised where supported.
+	/// @param type Media type of body, such as 'text/html; charset=utf-8'.
+	/// @param body Bytes of body.
+	/// @return True if body is valid in charset, or nothing if type is not text or its charset is not validated.
+	[[nodiscard]] constexpr auto validate_body(const media_type_view type, const std::string_view body) noexcept -> std::optional<bool>
+	{ return validate_body(charset_of(type), body); }
+
+	/// @brief Validate body against the charset of a media type known at compile time, so the validator is chosen at compile time.
+	/// @param body Bytes of body.
+	/// @return True if body is valid in charset, or nothing if type is not text or its charset is not validated.
+	template<fixed_string Literal>
+	[[nodiscard]] constexpr auto validate_body(const static_media_type<Literal>, const std::string_view body) noexcept -> std::optional<bool>
+	{
+		constexpr auto encoding = charset_of(static_media_type<Literal>::view());
+
+		if constexpr (encoding == charset::us_ascii)
+		{
+			return ascii::all_ascii(body);
+		}
+		else if constexpr (encoding == charset::utf_8)
+		{
+			return utf8::is_valid(body);
+		}
+		else
+		{
+			return std::nullopt;
+		}
+	}
+}
@@ -0,0 +1,349 @@
+#pragma once
+
+/*
+	https://www.iana.org/assignments/media-types/media-types.xhtml
+	https://svn.apache.org/repos/asf/httpd/httpd/trunk/docs/conf/mime.types
+*/
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief File extensions of common media types, laid out at compile time in a perfect-hash table.
+	/// @brief Lookups hash the extension twice and compare a single candidate, without locking nor allocating.
+	class media_type_extension
+	{
+		struct entry
+		{
+			std::string_view extension;
+			media_type_view type;
+		};
+
+		static constexpr std::uint16_t empty {0xFFFF};
+
+		/// @brief Lowercase extensions, the first listed for a type is its preferred extension.
+		static constexpr std::array entries {
+			entry {"html", "text/html"},
+			entry {"htm", "text/html"},
+			entry {"shtml", "text/html"},
+			entry {"css", "text/css"},
+			entry {"csv", "text/csv"},
+			entry {"js", "text/javascript"},
+			entry {"mjs", "text/javascript"},
+			entry {"md", "text/markdown"},
+			entry {"markdown", "text/markdown"},
+			entry {"mml", "text/mathml"},
+			entry {"txt", "text/plain"},
+			entry {"text", "text/plain"},
+			entry {"conf", "text/plain"},
+			entry {"def", "text/plain"},
+			entry {"list", "text/plain"},
+			entry {"log", "text/plain"},
+			entry {"ics", "text/calendar"},
+			entry {"vtt", "text/vtt"},
+			entry {"xml", "application/xml"},
+			entry {"xsl", "application/xml"},
+			entry {"xsd", "application/xml"},
+			entry {"xhtml", "application/xhtml+xml"},
+			entry {"xht", "application/xhtml+xml"},
+			entry {"atom", "application/atom+xml"},
+			entry {"rss", "application/rss+xml"},
+			entry {"json", "application/json"},
+			entry {"jsonld", "application/ld+json"},
+			entry {"webmanifest", "application/manifest+json"},
+			entry {"geojson", "application/geo+json"},
+			entry {"cbor", "application/cbor"},
+			entry {"yaml", "application/yaml"},
+			entry {"yml", "application/yaml"},
+			entry {"toml", "application/toml"},
+			entry {"sql", "application/sql"},
+			entry {"wasm", "application/wasm"},
+			entry {"pdf", "application/pdf"},
+			entry {"ps", "application/postscript"},
+			entry {"eps", "application/postscript"},
+			entry {"ai", "application/postscript"},
+			entry {"rtf", "application/rtf"},
+			entry {"epub", "application/epub+zip"},
+			entry {"jar", "application/java-archive"},
+			entry {"doc", "application/msword"},
+			entry {"dot", "application/msword"},
+			entry {"xls", "application/vnd.ms-excel"},
+			entry {"ppt", "application/vnd.ms-powerpoint"},
+			entry {"eot", "application/vnd.ms-fontobject"},
+			entry {"docx", "application/vnd.openxmlformats-officedocument.wordprocessingml.document"},
+			entry {"xlsx", "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet"},
+			entry {"pptx", "application/vnd.openxmlformats-officedocument.presentationml.presentation"},
+			entry {"odt", "application/vnd.oasis.opendocument.text"},
+			entry {"ods", "application/vnd.oasis.opendocument.spreadsheet"},
+			entry {"odp", "application/vnd.oasis.opendocument.presentation"},
+			entry {"odg", "application/vnd.oasis.opendocument.graphics"},
+			entry {"kml", "application/vnd.google-earth.kml+xml"},
+			entry {"kmz", "application/vnd.google-earth.kmz"},
+			entry {"m3u8", "application/vnd.apple.mpegurl"},
+			entry {"apk", "application/vnd.android.package-archive"},
+			entry {"rar", "application/vnd.rar"},
+			entry {"zip", "application/zip"},
+			entry {"gz", "application/gzip"},
+			entry {"zst", "application/zstd"},
+			entry {"7z", "application/x-7z-compressed"},
+			entry {"bz2", "application/x-bzip2"},
+			entry {"xz", "application/x-xz"},
+			entry {"tar", "application/x-tar"},
+			entry {"sh", "application/x-sh"},
+			entry {"rpm", "application/x-redhat-package-manager"},
+			entry {"der", "application/x-x509-ca-cert"},
+			entry {"pem", "application/x-x509-ca-cert"},
+			entry {"crt", "application/x-x509-ca-cert"},
+			entry {"bin", "application/octet-stream"},
+			entry {"exe", "application/octet-stream"},
+			entry {"dll", "application/octet-stream"},
+			entry {"deb", "application/octet-stream"},
+			entry {"dmg", "application/octet-stream"},
+			entry {"iso", "application/octet-stream"},
+			entry {"msi", "application/octet-stream"},
+			entry {"avif", "image/avif"},
+			entry {"apng", "image/apng"},
+			entry {"bmp", "image/bmp"},
+			entry {"gif", "image/gif"},
+			entry {"heic", "image/heic"},
+			entry {"heif", "image/heif"},
+			entry {"jpeg", "image/jpeg"},
+			entry {"jpg", "image/jpeg"},
+			entry {"jpe", "image/jpeg"},
+			entry {"jxl", "image/jxl"},
+			entry {"png", "image/png"},
+			entry {"svg", "image/svg+xml"},
+			entry {"svgz", "image/svg+xml"},
+			entry {"tiff", "image/tiff"},
+			entry {"tif", "image/tiff"},
+			entry {"psd", "image/vnd.adobe.photoshop"},
+			entry {"webp", "image/webp"},
+			entry {"ico", "image/x-icon"},
+			entry {"aac", "audio/aac"},
+			entry {"flac", "audio/flac"},
+			entry {"mid", "audio/midi"},
+			entry {"midi", "audio/midi"},
+			entry {"kar", "audio/midi"},
+			entry {"m4a", "audio/mp4"},
+			entry {"mp3", "audio/mpeg"},
+			entry {"ogg", "audio/ogg"},
+			entry {"oga", "audio/ogg"},
+			entry {"opus", "audio/ogg"},
+			entry {"wav", "audio/wav"},
+			entry {"weba", "audio/webm"},
+			entry {"3gpp", "video/3gpp"},
+			entry {"3gp", "video/3gpp"},
+			entry {"ts", "video/mp2t"},
+			entry {"mp4", "video/mp4"},
+			entry {"m4v", "video/mp4"},
+			entry {"mpeg", "video/mpeg"},
+			entry {"mpg", "video/mpeg"},
+			entry {"ogv", "video/ogg"},
+			entry {"mov", "video/quicktime"},
+			entry {"webm", "video/webm"},
+			entry {"flv", "video/x-flv"},
+			entry {"mkv", "video/x-matroska"},
+			entry {"wmv", "video/x-ms-wmv"},
+			entry {"avi", "video/x-msvideo"},
+			entry {"otf", "font/otf"},
+			entry {"ttf", "font/ttf"},
+			entry {"woff", "font/woff"},
+			entry {"woff2", "font/woff2"},
+			entry {"eml", "message/rfc822"},
+			entry {"glb", "model/gltf-binary"},
+			entry {"gltf", "model/gltf+json"},
+			entry {"obj", "model/obj"},
+			entry {"stl", "model/stl"},
+		};
+
+		/// @brief Twice as many slots as entries keeps the search for bucket seeds short.
+		static constexpr std::size_t slot_count {std::bit_ceil(entries.size() * 2)};
+
+		static constexpr std::size_t bucket_count {slot_count / 4};
+
+		/// @brief Case-insensitive FNV-1a with a seed, folding the high bits into the masked low bits.
+		/// @brief Closures rather than member functions, as they are needed while the class is still incomplete.
+		static constexpr auto hash = [](const std::string_view text, const std::uint32_t seed) noexcept -> std::uint32_t
+		{
+			std::uint32_t hash {2166136261u ^ (seed * 2654435769u)};
+
+			for (const auto character : text)
+			{
+				hash = (hash ^ static_cast<unsigned char>(ascii::to_lowercase(character))) * 16777619u;
+			}
+
+			return hash ^ (hash >> 15);
+		};
+
+		static constexpr auto bucket = [](const std::string_view extension) noexcept -> std::size_t
+		{ return hash(extension, 0) & (bucket_count - 1); };
+
+		static constexpr auto slot = [](const std::string_view extension, const std::uint32_t seed) noexcept -> std::size_t
+		{ return hash(extension, seed) & (slot_count - 1); };
+
+		/// @brief Hash and displace: each bucket gets the first seed that places all of its extensions in free slots.
+		struct table
+		{
+			std::array<std::uint16_t, bucket_count> seeds;
+			std::array<std::uint16_t, slot_count> slots;
+		};
+
+		static constexpr table lookup = []
+		{
+			table result {};
+			result.slots.fill(empty);
+
+			std::array<std::size_t, bucket_count> sizes {};
+
+			for (const auto& entry : entries)
+			{
+				++sizes[bucket(entry.extension)];
+			}
+
+			/* Largest buckets first, while most slots are still free. */
+			std::array<std::uint16_t, entries.size()> order {};
+			std::iota(order.begin(), order.end(), std::uint16_t {});
+			std::ranges::sort(order,
+							  [&](const std::uint16_t left, const std::uint16_t right)
+							  {
+								  const auto left_bucket = bucket(entries[left].extension);
+								  const auto right_bucket = bucket(entries[right].extension);
+
+								  if (sizes[left_bucket] != sizes[right_bucket])
+								  {
+									  return sizes[left_bucket] > sizes[right_bucket];
+								  }
+
+								  return left_bucket != right_bucket ? left_bucket < right_bucket : left < right;
+							  });
+
+			for (std::size_t begin {}; begin < order.size();)
+			{
+				const auto current = bucket(entries[order[begin]].extension);
+				const auto end = begin + sizes[current];
+
+				for (std::uint32_t seed {1};; ++seed)
+				{
+					if (seed == empty)
+					{
+						throw std::logic_error {"media type extension: no perfect hash seed, is an extension listed twice?"};
+					}
+
+					auto index = begin;
+
+					while (index < end and result.slots[slot(entries[order[index]].extension, seed)] == empty)
+					{
+						result.slots[slot(entries[order[index]].extension, seed)] = order[index];
+						++index;
+					}
+
+					if (index == end)
+					{
+						result.seeds[current] = static_cast<std::uint16_t>(seed);
+						break;
+					}
+
+					while (index-- != begin)
+					{
+						result.slots[slot(entries[order[index]].extension, seed)] = empty;
+					}
+				}
+
+				begin = end;
+			}
+
+			return result;
+		}();
+
+		static constexpr auto less_ignore_case = [](const std::string_view left, const std::string_view right) noexcept -> bool
+		{
+			return ascii::compare_ignore_case(left, right) < 0;
+		};
+
+		/// @brief Entry indices sorted by type, where equal types keep their listed order so the preferred extension comes first.
+		static constexpr auto by_type = []
+		{
+			std::array<std::uint16_t, entries.size()> result {};
+			std::iota(result.begin(), result.end(), std::uint16_t {});
+			std::ranges::sort(result,
+							  [](const std::uint16_t left, const std::uint16_t right)
+							  {
+								  const auto left_type = entries[left].type.string();
+								  const auto right_type = entries[right].type.string();
+
+								  if (left_type != right_type)
+								  {
+									  return less_ignore_case(left_type, right_type);
+								  }
+
+								  return left < right;
+							  });
+			return result;
+		}();
+
+	  public:
+		/// @brief Find media type of file extension.
+		/// @param extension File extension with or without leading '.', compared case-insensitively.
+		/// @return View of static storage, or nothing if extension is unknown.
+		[[nodiscard]] constexpr static auto find(std::string_view extension) noexcept -> std::optional<media_type_view>
+		{
+			if (extension.starts_with('.'))
+			{
+				extension.remove_prefix(1);
+			}
+
+			const auto index = lookup.slots[slot(extension, lookup.seeds[bucket(extension)])];
+
+			if (index != empty
+				and std::ranges::equal(entries[index].extension, extension, std::equal_to {}, {}, ascii::to_lowercase))
+			{
+				return entries[index].type;
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+
+		/// @brief Find preferred file extension of media type.
+		/// @param type Media type, parameters not considered.
+		/// @return Extension without leading '.', or nothing if there is none.
+		[[nodiscard]] constexpr static auto preferred(const media_type_view type) noexcept -> std::optional<std::string_view>
+		{
+			const auto result = std::ranges::lower_bound(by_type, type.string(), less_ignore_case,
+														 [](const std::uint16_t index) noexcept { return entries[index].type.string(); });
+
+			if (result != by_type.end() and entries[*result].type == type)
+			{
+				return entries[*result].extension;
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+	};
+
+	constexpr auto media_type_base::from_extension(const std::string_view extension) noexcept -> std::optional<media_type_view>
+	{ return media_type_extension::find(extension); }
+
+	template<typename Allocator>
+	constexpr auto basic_media_type<Allocator>::preferred_extension() const noexcept -> std::optional<std::string_view>
+	{ return media_type_extension::preferred(*this); }
+
+	constexpr auto media_type_view::preferred_extension() const noexcept -> std::optional<std::string_view>
+	{ return media_type_extension::preferred(*this); }
+}
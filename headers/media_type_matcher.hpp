@@ -0,0 +1,298 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace common_good
+{
+	/// @brief Routing of media types by patterns, 'type/subtype', 'type/prefix*', 'type/*+suffix' or '*/*' and combinations thereof.
+	/// @brief Patterns are compiled into tries over their lowercase characters, so a lookup walks the input once regardless of how many
+	/// patterns there are.
+	/// @brief The most specific subtype wins: an exact subtype before any prefix, a longer prefix before a shorter, and a matching
+	/// suffix before none. Only between subtypes as specific does a literal type win over '*', so 'application/vnd.foo.*' wins over
+	/// '*/*+json', which wins over 'application/*', which wins over '*/*'.
+	/// @tparam Type Value associated with each pattern.
+	template<typename Type>
+	class media_type_matcher
+	{
+		static constexpr std::uint32_t none {0xFFFFFFFF};
+
+		/// @brief Trie node with edges kept in a small flat list, restricted-name characters bound its length.
+		struct node
+		{
+			std::vector<std::pair<char, std::uint32_t>> children;
+
+			/// @brief Value of a pattern ending at this node without '*'.
+			std::uint32_t exact {none};
+
+			/// @brief Values of patterns with '*' at this node, by suffix identifier where 0 is no suffix.
+			/// @brief Bounded by the number of distinct suffixes, not by the number of patterns.
+			std::vector<std::pair<std::uint32_t, std::uint32_t>> wildcards;
+		};
+
+		/// @brief Root of full patterns with literal type.
+		static constexpr std::uint32_t literal_root {0};
+
+		/// @brief Root of subtype patterns with type '*'.
+		static constexpr std::uint32_t wildcard_root {1};
+
+		/// @brief Root of suffixes, whose `exact` is the suffix identifier.
+		static constexpr std::uint32_t suffix_root {2};
+
+		std::vector<node> nodes {3};
+		std::vector<Type> values;
+		std::uint32_t suffix_count {};
+
+		[[nodiscard]] constexpr auto child(const std::uint32_t parent, const char character) const noexcept -> std::uint32_t
+		{
+			for (const auto& edge : nodes[parent].children)
+			{
+				if (edge.first == character)
+				{
+					return edge.second;
+				}
+			}
+
+			return none;
+		}
+
+		constexpr auto emplace_path(std::uint32_t parent, const std::string_view text) -> std::uint32_t
+		{
+			for (const auto character : text)
+			{
+				const auto lowercase = ascii::to_lowercase(character);
+
+				if (const auto next = child(parent, lowercase); next != none)
+				{
+					parent = next;
+				}
+				else
+				{
+					const auto index = static_cast<std::uint32_t>(nodes.size());
+					nodes.emplace_back();
+					nodes[parent].children.emplace_back(lowercase, index);
+					parent = index;
+				}
+			}
+
+			return parent;
+		}
+
+		constexpr auto store(std::uint32_t& slot, Type&& value) -> void
+		{
+			if (slot == none)
+			{
+				slot = static_cast<std::uint32_t>(values.size());
+				values.push_back(std::move(value));
+			}
+			else
+			{
+				values[slot] = std::move(value);
+			}
+		}
+
+		/// @brief Value of the most specific pattern on a walk, with how specific its subtype is.
+		struct match
+		{
+			const Type* value {};
+
+			/// @brief Twice the characters of subtype prefix matched, one more for a matching suffix, highest for an exact subtype.
+			std::size_t rank {};
+		};
+
+		/// @brief Walk text from node, returning the most specific value on the way.
+		/// @param offset Characters of text before the subtype, which do not count towards the rank.
+		[[nodiscard]] constexpr auto walk(std::uint32_t current, const std::string_view text, const std::size_t offset,
+										  const std::uint32_t suffix) const noexcept -> match
+		{
+			auto best = none;
+			std::size_t rank {};
+
+			for (std::size_t index {};; ++index)
+			{
+				auto general = none;
+				auto specific = none;
+
+				for (const auto& wildcard : nodes[current].wildcards)
+				{
+					if (wildcard.first == 0)
+					{
+						general = wildcard.second;
+					}
+					else if (wildcard.first == suffix)
+					{
+						specific = wildcard.second;
+					}
+				}
+
+				if (specific != none)
+				{
+					best = specific;
+					rank = (index - offset) * 2 + 1;
+				}
+				else if (general != none)
+				{
+					best = general;
+					rank = (index - offset) * 2;
+				}
+
+				if (index == text.size())
+				{
+					if (nodes[current].exact != none)
+					{
+						best = nodes[current].exact;
+						rank = (index - offset + 1) * 2;
+					}
+
+					break;
+				}
+
+				if (current = child(current, ascii::to_lowercase(text[index])); current == none)
+				{
+					break;
+				}
+			}
+
+			return {best != none ? &values[best] : nullptr, rank};
+		}
+
+	  public:
+		[[nodiscard]] constexpr media_type_matcher() = default;
+
+		/// @brief Add pattern, replacing the value of an equal pattern.
+		/// @param pattern Media type in format 'type/subtype+suffix', where type may be '*' and subtype may end in '*' before any suffix.
+		/// Parameters are not considered.
+		/// @param value Value returned for media types matching pattern.
+		/// @exception media_type::parsing_error If pattern with '*' replaced fail to parse as media type.
+		constexpr void insert(const std::string_view pattern, Type value)
+		{
+			/* Only the type before any parameters may hold '*', as only it becomes the key. */
+			auto type = pattern.substr(0, pattern.find(';'));
+
+			while (not type.empty() and ascii::is_blank(type.back()))
+			{
+				type.remove_suffix(1);
+			}
+
+			const auto slash = type.find('/');
+
+			if (slash == std::string_view::npos)
+			{
+				throw media_type::parsing_error {media_type::error::missing_slash};
+			}
+
+			const auto wildcard_type = type.substr(0, slash) == "*";
+			const auto star = type.find('*', slash + 1);
+
+			if (star != std::string_view::npos and star + 1 < type.size() and type[star + 1] != '+')
+			{
+				throw media_type::parsing_error {media_type::error::subtype_character};
+			}
+
+			/* Each '*' stand in for a single valid character, so any other fault is reported as for a media type. */
+			std::string probe {pattern};
+
+			if (wildcard_type)
+			{
+				probe[0] = 'x';
+			}
+
+			if (star != std::string_view::npos)
+			{
+				probe[star] = 'x';
+			}
+
+			const auto parsed = media_type_view::try_parse(probe);
+
+			if (not parsed)
+			{
+				throw media_type::parsing_error {parsed.error()};
+			}
+
+			const auto key = pattern.substr(0, parsed->string().size());
+			auto current = wildcard_type ? wildcard_root : literal_root;
+			const auto text = wildcard_type ? key.substr(slash + 1) : key;
+
+			if (star == std::string_view::npos)
+			{
+				store(nodes[emplace_path(current, text)].exact, std::move(value));
+				return;
+			}
+
+			current = emplace_path(current, text.substr(0, star - (key.size() - text.size())));
+
+			std::uint32_t constraint {};
+
+			if (const auto suffix = key.substr(star + 1); not suffix.empty())
+			{
+				auto& identifier = nodes[emplace_path(suffix_root, suffix)].exact;
+
+				if (identifier == none)
+				{
+					identifier = ++suffix_count;
+				}
+
+				constraint = identifier;
+			}
+
+			for (auto& wildcard : nodes[current].wildcards)
+			{
+				if (wildcard.first == constraint)
+				{
+					store(wildcard.second, std::move(value));
+					return;
+				}
+			}
+
+			auto slot = none;
+			store(slot, std::move(value));
+			nodes[current].wildcards.emplace_back(constraint, slot);
+		}
+
+		/// @brief Find value of the most specific pattern matching media type, in time linear in its length.
+		/// @param type Media type, parameters not considered.
+		/// @return Value, or null if no pattern match.
+		[[nodiscard]] constexpr auto find(const media_type_view type) const noexcept -> const Type*
+		{
+			std::uint32_t suffix {};
+
+			if (const auto text = type.suffix(); not text.empty())
+			{
+				auto current = suffix_root;
+
+				for (std::size_t index {}; index < text.size() and current != none; ++index)
+				{
+					current = child(current, ascii::to_lowercase(text[index]));
+				}
+
+				if (current != none and nodes[current].exact != none)
+				{
+					suffix = nodes[current].exact;
+				}
+			}
+
+			const auto literal = walk(literal_root, type.string(), type.type().size() + 1, suffix);
+			const auto wildcard = walk(wildcard_root, type.string().substr(type.type().size() + 1), 0, suffix);
+
+			/* A literal type only decides between subtypes as specific. */
+			if (literal.value and (not wildcard.value or literal.rank >= wildcard.rank))
+			{
+				return literal.value;
+			}
+
+			return wildcard.value;
+		}
+
+		/// @brief Get number of distinct patterns.
+		[[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return values.size(); }
+	};
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "small_vector.hpp"
+#include "stats.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Incremental media type parser, for input arriving in several chunks such as header bytes spread over `recv()` buffers.
+	/// @brief Validates as characters arrive and reports the same errors as `media_type::try_parse` on the joined input. Type
+	/// characters are kept in a fixed scratch area, and parameters are written directly in canonical form, so chunks are never
+	/// joined.
+	class media_type_parser
+	{
+		/// @brief Longest valid type: top-level type, '/', tree, subtype and suffix at their maximum lengths.
+		static constexpr std::size_t scratch_size {512};
+
+		/// @brief Position within the RFC 9110 parameter grammar.
+		enum class state : unsigned char
+		{
+			before_name,
+			name,
+			before_value,
+			token,
+			quoted,
+			escaped,
+			after_value,
+		};
+
+		media_type::scanner scanner {};
+
+		/// @brief Lowercase characters before ';'. Any beyond the scratch area are blanks before ';', or the type is invalid anyway.
+		std::array<char, scratch_size> characters {};
+		std::size_t fed {};
+
+		bool in_parameters {};
+		state parameter_state {state::before_name};
+		std::optional<media_type::error> failure {};
+
+		std::string parameter_text;
+		small_vector<media_type::parameter_offset, 2> parameter_offsets;
+		std::uint32_t name_offset {};
+		std::uint32_t name_size {};
+		std::uint32_t value_offset {};
+
+		constexpr auto fail(const media_type::error code) noexcept -> bool
+		{
+			failure = code;
+			return false;
+		}
+
+		constexpr void emit()
+		{
+			parameter_offsets.push_back(media_type::parameter_offset {name_offset, name_size, value_offset,
+																	  static_cast<std::uint32_t>(parameter_text.size()) - value_offset});
+		}
+
+		/// @brief Consume character of parameters, mirroring `media_type::parse_parameters` one character at a time.
+		constexpr auto consume_parameter(const char character) -> bool
+		{
+			const auto is_token = ascii::matches(character, ascii::character_class::token);
+			const auto is_blank = ascii::is_blank(character);
+
+			switch (parameter_state)
+			{
+				case state::before_name:
+					if (is_blank or character == ';')
+					{
+						return true;
+					}
+
+					if (not is_token)
+					{
+						return fail(media_type::error::parameter_name);
+					}
+
+					if (not parameter_text.empty())
+					{
+						parameter_text.push_back(';');
+					}
+
+					name_offset = static_cast<std::uint32_t>(parameter_text.size());
+					parameter_text.push_back(ascii::to_lowercase(character));
+					parameter_state = state::name;
+					return true;
+
+				case state::name:
+					if (is_token)
+					{
+						parameter_text.push_back(ascii::to_lowercase(character));
+						return true;
+					}
+
+					if (character != '=')
+					{
+						return fail(media_type::error::parameter_missing_equals);
+					}
+
+					name_size = static_cast<std::uint32_t>(parameter_text.size()) - name_offset;
+					parameter_text.push_back('=');
+					parameter_state = state::before_value;
+					return true;
+
+				case state::before_value:
+					if (character == '"')
+					{
+						parameter_text.push_back('"');
+						value_offset = static_cast<std::uint32_t>(parameter_text.size());
+						parameter_state = state::quoted;
+						return true;
+					}
+
+					if (not is_token)
+					{
+						return fail(media_type::error::parameter_value);
+					}
+
+					value_offset = static_cast<std::uint32_t>(parameter_text.size());
+					parameter_text.push_back(character);
+					parameter_state = state::token;
+					return true;
+
+				case state::token:
+					if (is_token)
+					{
+						parameter_text.push_back(character);
+						return true;
+					}
+
+					if (character != ';' and not is_blank)
+					{
+						return fail(media_type::error::parameter_value);
+					}
+
+					emit();
+					parameter_state = character == ';' ? state::before_name : state::after_value;
+					return true;
+
+				case state::quoted:
+					if (character == '"')
+					{
+						emit();
+						parameter_text.push_back('"');
+						parameter_state = state::after_value;
+						return true;
+					}
+
+					if (ascii::is_control(character) and character != '\t')
+					{
+						return fail(media_type::error::parameter_value);
+					}
+
+					parameter_text.push_back(character);
+					parameter_state = character == '\\' ? state::escaped : state::quoted;
+					return true;
+
+				case state::escaped:
+					if (ascii::is_control(character) and character != '\t')
+					{
+						return fail(media_type::error::parameter_value);
+					}
+
+					parameter_text.push_back(character);
+					parameter_state = state::quoted;
+					return true;
+
+				case state::after_value:
+					if (is_blank)
+					{
+						return true;
+					}
+
+					if (character != ';')
+					{
+						return fail(media_type::error::parameter_missing_semicolon);
+					}
+
+					parameter_state = state::before_name;
+					return true;
+			}
+
+			return true;
+		}
+
+		/// @brief Validate what remains of the parameters after the last character.
+		[[nodiscard]] constexpr auto finish_parameters() -> std::expected<void, media_type::error>
+		{
+			switch (parameter_state)
+			{
+				case state::name: return std::unexpected {media_type::error::parameter_missing_equals};
+				case state::before_value:
+				case state::escaped: return std::unexpected {media_type::error::parameter_value};
+				case state::quoted: return std::unexpected {media_type::error::parameter_unterminated_quote};
+				case state::token: emit(); return {};
+				case state::before_name:
+				case state::after_value: return {};
+			}
+
+			return {};
+		}
+
+	  public:
+		[[nodiscard]] constexpr media_type_parser() = default;
+
+		/// @brief Consume next chunk of input.
+		/// @param chunk Characters following those of previous chunks, need not outlive the call.
+		/// @return False if input is already known to be invalid, further chunks are then ignored. Some faults are only known
+		/// when finished.
+		constexpr auto feed(const std::string_view chunk) -> bool
+		{
+			for (const auto character : chunk)
+			{
+				if (failure)
+				{
+					return false;
+				}
+
+				if (in_parameters)
+				{
+					consume_parameter(character);
+				}
+				else if (const auto lowercase = ascii::to_lowercase(character); scanner.consume(lowercase))
+				{
+					if (fed < characters.size())
+					{
+						characters[fed] = lowercase;
+					}
+
+					++fed;
+				}
+				else if (scanner.parameters() != std::string_view::npos)
+				{
+					in_parameters = true;
+				}
+				else
+				{
+					/* The scanner has stopped on an error, which it reports again when finished. */
+					failure = scanner.finish().error();
+				}
+			}
+
+			return not failure;
+		}
+
+		/// @brief Validate what remains after the last chunk, reporting the first fault in the order of `media_type::try_parse`.
+		/// @return Media type, or the first validation error encountered.
+		[[nodiscard]] constexpr auto finish() && -> std::expected<media_type, media_type::error>
+		{
+			return stats::measure([&]() -> std::expected<media_type, media_type::error>
+			{
+				const auto offset = scanner.finish();
+
+				if (not offset)
+				{
+					return std::unexpected {offset.error()};
+				}
+
+				if (failure)
+				{
+					return std::unexpected {*failure};
+				}
+
+				if (in_parameters)
+				{
+					if (const auto result = finish_parameters(); not result)
+					{
+						return std::unexpected {result.error()};
+					}
+				}
+
+				media_type result {std::string {characters.data(), scanner.size()}, *offset};
+				result.parameter_text = std::move(parameter_text);
+				result.parameter_offsets = std::move(parameter_offsets);
+				result.derive();
+				return result;
+			});
+		}
+	};
+}
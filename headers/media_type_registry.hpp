@@ -0,0 +1,366 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Media type interned by a `media_type_registry`, equality and hashing are integer operations.
+	/// @brief Identifiers are dense and only comparable between types interned by the same registry, except for well-known types
+	/// whose identifiers are the same in every registry.
+	class interned_media_type
+	{
+		std::uint32_t identifier {};
+
+		[[nodiscard]] constexpr explicit interned_media_type(const std::uint32_t identifier) noexcept : identifier {identifier} { }
+
+		friend class media_type_registry;
+
+	  public:
+		[[nodiscard]] constexpr auto operator==(const interned_media_type& other) const noexcept -> bool = default;
+
+		/// @brief Get dense identifier, suitable as index into flat dispatch tables.
+		[[nodiscard]] constexpr auto id() const noexcept -> std::uint32_t { return identifier; }
+	};
+
+	/// @brief Thread-safe interning of canonical media types into dense `interned_media_type` identifiers.
+	/// @brief Common IANA types are pre-seeded at compile time and resolved without taking any lock. Other types are spread over
+	/// shards by hash, each locked on its own, and viewed by identifier through a directory that takes no lock.
+	class media_type_registry
+	{
+		/// @brief Hash of the lowercase form, so lookups by non-canonical views need no lowercased copy.
+		struct hash_ignore_case
+		{
+			[[nodiscard]] constexpr auto operator()(const std::string_view string) const noexcept -> std::size_t
+			{ return media_type::hash_ignore_case(string); }
+		};
+
+		struct equal_ignore_case
+		{
+			[[nodiscard]] constexpr auto operator()(const std::string_view left, const std::string_view right) const noexcept -> bool
+			{ return ascii::equals_ignore_case(left, right); }
+		};
+
+		/// @brief Closure rather than member function, as it is needed while the class is still incomplete.
+		static constexpr auto less_ignore_case = [](const std::string_view left, const std::string_view right) noexcept -> bool
+		{
+			return ascii::compare_ignore_case(left, right) < 0;
+		};
+
+		/// @brief Independently locked part of the registry, so threads interning different types rarely contend.
+		/// @brief Aligned to a cache line of its own, so one shard's lock never shares a line with another's.
+		struct alignas(64) shard
+		{
+			mutable std::shared_mutex mutex;
+
+			/// @brief Types interned into this shard, deque keeps addresses stable so keys and the directory can view into the elements.
+			std::deque<media_type> types;
+
+			std::unordered_map<std::string_view, std::uint32_t, hash_ignore_case, equal_ignore_case> identifiers;
+		};
+
+		static constexpr std::size_t shard_count {16};
+
+		/// @brief Entries in the first directory segment, each following segment twice the size of the one before.
+		static constexpr std::size_t segment_base {64};
+
+		/// @brief Enough segments for every identifier.
+		static constexpr std::size_t segment_count {27};
+
+		using slot = std::atomic<const media_type*>;
+
+		std::array<shard, shard_count> shards;
+
+		/// @brief Dynamically interned types by identifier less the well-known, published once stored so `view` takes no lock.
+		std::array<std::atomic<slot*>, segment_count> segments {};
+
+		/// @brief Next identifier less the well-known, only taken while holding the lock of the shard the type is stored in, once its
+		/// directory segment is allocated.
+		std::atomic<std::uint32_t> next {};
+
+		/// @brief Identifiers less the well-known below which every directory entry is stored, never ahead of `next`.
+		std::atomic<std::uint32_t> published {};
+
+		[[nodiscard]] auto shard_of(const std::string_view type) noexcept -> shard& { return shards[hash_ignore_case {}(type) % shard_count]; }
+
+		[[nodiscard]] auto shard_of(const std::string_view type) const noexcept -> const shard&
+		{ return shards[hash_ignore_case {}(type) % shard_count]; }
+
+		/// @brief Locate directory entry of identifier less the well-known.
+		/// @return Segment and index within segment.
+		[[nodiscard]] constexpr static auto locate(const std::uint32_t index) noexcept -> std::pair<std::size_t, std::size_t>
+		{
+			const auto segment = static_cast<std::size_t>(std::bit_width(index / segment_base + 1)) - 1;
+			return {segment, index - ((std::size_t {1} << segment) - 1) * segment_base};
+		}
+
+		/// @brief Allocate directory segment of identifier less the well-known, unless already allocated.
+		void reserve(const std::uint32_t index)
+		{
+			const auto segment = locate(index).first;
+			auto* entries = segments[segment].load(std::memory_order_acquire);
+
+			if (not entries)
+			{
+				/* Threads of different shards may race to allocate the same segment, the loser frees its own. */
+				auto* allocated = new slot[segment_base << segment] {};
+
+				if (not segments[segment].compare_exchange_strong(entries, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					delete[] allocated;
+				}
+			}
+		}
+
+		/// @brief Get directory entry of identifier less the well-known, whose segment is reserved.
+		[[nodiscard]] auto entry(const std::uint32_t index) noexcept -> slot&
+		{
+			const auto [segment, offset] = locate(index);
+			return segments[segment].load(std::memory_order_acquire)[offset];
+		}
+
+		/// @brief Get directory entry of identifier less the well-known if already stored, without allocating.
+		/// @brief Sequentially consistent, as is the store in `intern`, so of two threads storing neighbouring entries at least one
+		/// sees the other's and the published count never stalls below a stored entry.
+		[[nodiscard]] auto stored(const std::uint32_t index) const noexcept -> const media_type*
+		{
+			const auto [segment, offset] = locate(index);
+			const auto* entries = segments[segment].load();
+			return entries ? entries[offset].load() : nullptr;
+		}
+
+		/// @brief Advance published count past every entry stored, whichever thread stored it.
+		void publish() noexcept
+		{
+			auto count = published.load();
+
+			while (stored(count))
+			{
+				/* A failed exchange reloads count, as another thread advanced it. */
+				if (published.compare_exchange_weak(count, count + 1))
+				{
+					++count;
+				}
+			}
+		}
+
+		/// @brief Find dynamically interned type in shard, which must be locked by the caller.
+		[[nodiscard]] static auto find_locked(const shard& shard, const std::string_view type) -> std::optional<interned_media_type>
+		{
+			if (const auto result = shard.identifiers.find(type); result != shard.identifiers.end())
+			{
+				return interned_media_type {result->second};
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+
+	  public:
+		/// @brief Pre-seeded types in lowercase sorted order, identifier is the index.
+		static constexpr std::array well_known {
+			media_type_view {"application/atom+xml"},
+			media_type_view {"application/cbor"},
+			media_type_view {"application/ecmascript"},
+			media_type_view {"application/geo+json"},
+			media_type_view {"application/gzip"},
+			media_type_view {"application/javascript"},
+			media_type_view {"application/json"},
+			media_type_view {"application/ld+json"},
+			media_type_view {"application/msgpack"},
+			media_type_view {"application/octet-stream"},
+			media_type_view {"application/pdf"},
+			media_type_view {"application/problem+json"},
+			media_type_view {"application/problem+xml"},
+			media_type_view {"application/rss+xml"},
+			media_type_view {"application/vnd.api+json"},
+			media_type_view {"application/wasm"},
+			media_type_view {"application/x-www-form-urlencoded"},
+			media_type_view {"application/xhtml+xml"},
+			media_type_view {"application/xml"},
+			media_type_view {"application/zip"},
+			media_type_view {"audio/aac"},
+			media_type_view {"audio/mpeg"},
+			media_type_view {"audio/ogg"},
+			media_type_view {"audio/wav"},
+			media_type_view {"audio/webm"},
+			media_type_view {"font/otf"},
+			media_type_view {"font/ttf"},
+			media_type_view {"font/woff"},
+			media_type_view {"font/woff2"},
+			media_type_view {"image/avif"},
+			media_type_view {"image/bmp"},
+			media_type_view {"image/gif"},
+			media_type_view {"image/jpeg"},
+			media_type_view {"image/png"},
+			media_type_view {"image/svg+xml"},
+			media_type_view {"image/webp"},
+			media_type_view {"image/x-icon"},
+			media_type_view {"multipart/byteranges"},
+			media_type_view {"multipart/form-data"},
+			media_type_view {"multipart/mixed"},
+			media_type_view {"text/css"},
+			media_type_view {"text/csv"},
+			media_type_view {"text/event-stream"},
+			media_type_view {"text/html"},
+			media_type_view {"text/javascript"},
+			media_type_view {"text/markdown"},
+			media_type_view {"text/plain"},
+			media_type_view {"text/xml"},
+			media_type_view {"video/mp4"},
+			media_type_view {"video/mpeg"},
+			media_type_view {"video/ogg"},
+			media_type_view {"video/webm"},
+		};
+
+		static_assert(std::ranges::is_sorted(well_known, less_ignore_case, &media_type_view::string));
+
+		/// @brief Find well-known type without a registry, usable in constant expressions.
+		/// @param type Media type to look up, compared case-insensitively.
+		/// @return Interned type, or nothing if type is not pre-seeded.
+		[[nodiscard]] constexpr static auto find_well_known(const media_type_view type) noexcept -> std::optional<interned_media_type>
+		{
+			const auto result = std::ranges::lower_bound(well_known, type.string(), less_ignore_case, &media_type_view::string);
+
+			if (result != well_known.end() and *result == type)
+			{
+				return interned_media_type {static_cast<std::uint32_t>(result - well_known.begin())};
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+
+		/// @brief Get identifier of well-known type at compile time, for flat dispatch tables.
+		/// @param type Pre-seeded media type, anything else fail to compile.
+		[[nodiscard]] consteval static auto well_known_id(const std::string_view type) -> interned_media_type
+		{ return find_well_known(media_type_view {type}).value(); }
+
+		[[nodiscard]] media_type_registry() = default;
+		media_type_registry(const media_type_registry&) = delete;
+		auto operator=(const media_type_registry&) -> media_type_registry& = delete;
+
+		~media_type_registry()
+		{
+			for (auto& segment : segments)
+			{
+				delete[] segment.load(std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief Find already interned type without interning it. Locks only the shard of type, and only for reading.
+		/// @param type Media type to look up, compared case-insensitively.
+		/// @return Interned type, or nothing if type has not been interned.
+		[[nodiscard]] auto find(const media_type_view type) const -> std::optional<interned_media_type>
+		{
+			if (const auto result = find_well_known(type))
+			{
+				return result;
+			}
+
+			const auto& shard = shard_of(type.string());
+			const std::shared_lock lock {shard.mutex};
+			return find_locked(shard, type.string());
+		}
+
+		/// @brief Intern type, storing a canonical copy the first time it is seen. Locks only the shard of type.
+		/// @param type Media type to intern, compared case-insensitively.
+		/// @return Interned type, the same for every type comparing equal.
+		[[nodiscard]] auto intern(const media_type_view type) -> interned_media_type
+		{
+			if (const auto result = find(type))
+			{
+				return *result;
+			}
+
+			auto& shard = shard_of(type.string());
+			const std::unique_lock lock {shard.mutex};
+
+			/* Another thread may have interned the type between the locks. */
+			if (const auto result = find_locked(shard, type.string()))
+			{
+				return *result;
+			}
+
+			/* Every step that may throw comes before the identifier is taken and is undone on failure, as an identifier never
+			 * stored would stall `publish` for good. The placeholder is only seen under the lock held here. */
+			const auto& canonical = shard.types.emplace_back(type);
+
+			const auto position = [&]
+			{
+				try
+				{
+					return shard.identifiers.emplace(canonical.string(), 0).first;
+				}
+				catch (...)
+				{
+					shard.types.pop_back();
+					throw;
+				}
+			}();
+
+			auto index = next.load(std::memory_order_relaxed);
+
+			try
+			{
+				/* The segment of the identifier about to be taken is reserved first, so storing into it cannot fail. */
+				do
+				{
+					reserve(index);
+				} while (not next.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+			}
+			catch (...)
+			{
+				shard.identifiers.erase(position);
+				shard.types.pop_back();
+				throw;
+			}
+
+			position->second = static_cast<std::uint32_t>(well_known.size()) + index;
+			entry(index).store(&canonical);
+			publish();
+			return interned_media_type {position->second};
+		}
+
+		/// @brief Get interned type, without taking any lock.
+		/// @param type Type interned by this registry.
+		/// @return View of the canonical form, valid as long as the registry.
+		[[nodiscard]] auto view(const interned_media_type type) const -> media_type_view
+		{
+			if (type.identifier < well_known.size())
+			{
+				return well_known[type.identifier];
+			}
+
+			const auto [segment, offset] = locate(type.identifier - static_cast<std::uint32_t>(well_known.size()));
+			return *segments[segment].load(std::memory_order_acquire)[offset].load(std::memory_order_acquire);
+		}
+
+		/// @brief Get number of interned types, well-known types included. Every identifier below the size can be viewed.
+		[[nodiscard]] auto size() const noexcept -> std::size_t { return well_known.size() + published.load(std::memory_order_acquire); }
+	};
+}
+
+template<>
+struct std::hash<common_good::interned_media_type>
+{
+	[[nodiscard]] constexpr auto operator()(const common_good::interned_media_type& type) const noexcept -> std::size_t { return type.id(); }
+};
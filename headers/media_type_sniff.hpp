@@ -0,0 +1,442 @@
+#pragma once
+
+/*
+	https://mimesniff.spec.whatwg.org/#rules-for-identifying-an-unknown-mime-type
+*/
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__SSE2__) or defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+namespace common_good
+{
+	/// @brief Byte patterns of the WHATWG MIME sniffing algorithm, see `sniff`.
+	namespace sniffing
+	{
+		/// @brief Bytes inspected by the algorithm, the resource header.
+		static constexpr std::size_t header_size {512};
+
+		/// @brief Every pattern fits a single 16 byte vector, the tag-terminating byte of HTML patterns included.
+		static constexpr std::size_t window_size {16};
+
+		using window = std::array<std::uint8_t, window_size>;
+
+		/// @brief Pattern matched as '(byte & mask) == pattern' over the whole window, both mask and pattern zero past `length`.
+		struct signature
+		{
+			window pattern;
+			window mask;
+			std::size_t length;
+			media_type_view type;
+
+			/// @brief Leading whitespace bytes are ignored before matching.
+			bool skip_whitespace;
+
+			/// @brief Pattern must be followed by a tag-terminating byte, ' ' or '>'.
+			bool tag_terminated;
+
+			/// @brief Only matched when the sniff-scriptable flag is set.
+			bool scriptable;
+		};
+
+		/// @brief Pattern with mask, both as string literals of equal length.
+		template<std::size_t Size>
+		[[nodiscard]] consteval auto masked(const char (&pattern)[Size], const char (&mask)[Size], const media_type_view type) -> signature
+		{
+			static_assert(Size - 1 <= window_size);
+
+			signature result {{}, {}, Size - 1, type, false, false, false};
+
+			for (std::size_t index {}; index < Size - 1; ++index)
+			{
+				result.mask[index] = static_cast<std::uint8_t>(mask[index]);
+				result.pattern[index] = static_cast<std::uint8_t>(static_cast<std::uint8_t>(pattern[index]) & result.mask[index]);
+			}
+
+			return result;
+		}
+
+		/// @brief Pattern matched exactly.
+		template<std::size_t Size>
+		[[nodiscard]] consteval auto exact(const char (&pattern)[Size], const media_type_view type) -> signature
+		{
+			char mask[Size] {};
+			std::ranges::fill_n(mask, Size - 1, '\xFF');
+			return masked(pattern, mask, type);
+		}
+
+		/// @brief HTML pattern, letters matched case-insensitively after leading whitespace and followed by a tag-terminating byte.
+		template<std::size_t Size>
+		[[nodiscard]] consteval auto html(const char (&tag)[Size]) -> signature
+		{
+			char mask[Size] {};
+
+			for (std::size_t index {}; index < Size - 1; ++index)
+			{
+				mask[index] = ascii::is_alphabetic(tag[index]) ? '\xDF' : '\xFF';
+			}
+
+			auto result = masked(tag, mask, "text/html");
+			result.skip_whitespace = true;
+			result.tag_terminated = true;
+			result.scriptable = true;
+			return result;
+		}
+
+		/// @brief Scriptable pattern matched exactly after leading whitespace.
+		template<std::size_t Size>
+		[[nodiscard]] consteval auto scriptable(const char (&pattern)[Size], const media_type_view type, const bool skip_whitespace) -> signature
+		{
+			auto result = exact(pattern, type);
+			result.skip_whitespace = skip_whitespace;
+			result.scriptable = true;
+			return result;
+		}
+
+		/// @brief Patterns in the order of the algorithm, the first match wins.
+		static constexpr std::array signatures {
+			html("<!DOCTYPE HTML"),
+			html("<HTML"),
+			html("<HEAD"),
+			html("<SCRIPT"),
+			html("<IFRAME"),
+			html("<H1"),
+			html("<DIV"),
+			html("<FONT"),
+			html("<TABLE"),
+			html("<A"),
+			html("<STYLE"),
+			html("<TITLE"),
+			html("<B"),
+			html("<BODY"),
+			html("<BR"),
+			html("<P"),
+			html("<!--"),
+			scriptable("<?xml", "text/xml", true),
+			scriptable("%PDF-", "application/pdf", false),
+			exact("%!PS-Adobe-", "application/postscript"),
+			masked("\xFE\xFF\x00\x00", "\xFF\xFF\x00\x00", "text/plain"),
+			masked("\xFF\xFE\x00\x00", "\xFF\xFF\x00\x00", "text/plain"),
+			exact("\xEF\xBB\xBF", "text/plain"),
+			exact("\x00\x00\x01\x00", "image/x-icon"),
+			exact("\x00\x00\x02\x00", "image/x-icon"),
+			exact("BM", "image/bmp"),
+			exact("GIF87a", "image/gif"),
+			exact("GIF89a", "image/gif"),
+			masked("RIFF\x00\x00\x00\x00WEBPVP", "\xFF\xFF\xFF\xFF\x00\x00\x00\x00\xFF\xFF\xFF\xFF\xFF\xFF", "image/webp"),
+			exact("\x89PNG\r\n\x1A\n", "image/png"),
+			exact("\xFF\xD8\xFF", "image/jpeg"),
+			masked("FORM\x00\x00\x00\x00" "AIFF", "\xFF\xFF\xFF\xFF\x00\x00\x00\x00\xFF\xFF\xFF\xFF", "audio/aiff"),
+			exact("ID3", "audio/mpeg"),
+			exact("OggS\x00", "application/ogg"),
+			exact("MThd\x00\x00\x00\x06", "audio/midi"),
+			masked("RIFF\x00\x00\x00\x00" "AVI ", "\xFF\xFF\xFF\xFF\x00\x00\x00\x00\xFF\xFF\xFF\xFF", "video/avi"),
+			masked("RIFF\x00\x00\x00\x00WAVE", "\xFF\xFF\xFF\xFF\x00\x00\x00\x00\xFF\xFF\xFF\xFF", "audio/wave"),
+			exact("\x1F\x8B\x08", "application/x-gzip"),
+			exact("PK\x03\x04", "application/zip"),
+			exact("Rar \x1A\x07\x00", "application/x-rar-compressed"),
+		};
+
+		static_assert(signatures.size() <= 64);
+
+		/// @brief Signatures matched against the window after leading whitespace, all others match the window at the start.
+		static constexpr auto skipping_whitespace = []
+		{
+			std::uint64_t result {};
+
+			for (std::size_t index {}; index < signatures.size(); ++index)
+			{
+				result |= signatures[index].skip_whitespace ? std::uint64_t {1} << index : 0;
+			}
+
+			return result;
+		}();
+
+		static constexpr auto scriptable_signatures = []
+		{
+			std::uint64_t result {};
+
+			for (std::size_t index {}; index < signatures.size(); ++index)
+			{
+				result |= signatures[index].scriptable ? std::uint64_t {1} << index : 0;
+			}
+
+			return result;
+		}();
+
+		/// @brief Signatures whose first byte can match, per byte value, so only those few are compared.
+		static constexpr auto candidates = []
+		{
+			std::array<std::uint64_t, 256> result {};
+
+			for (unsigned byte {}; byte < result.size(); ++byte)
+			{
+				for (std::size_t index {}; index < signatures.size(); ++index)
+				{
+					if ((byte & signatures[index].mask[0]) == signatures[index].pattern[0])
+					{
+						result[byte] |= std::uint64_t {1} << index;
+					}
+				}
+			}
+
+			return result;
+		}();
+
+		/// @brief Compare whole window against masked pattern. Vectorised where supported.
+		[[nodiscard]] constexpr auto matches(const window& bytes, const signature& signature) noexcept -> bool
+		{
+			if !consteval
+			{
+#if defined(__SSE2__)
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes.data()));
+				const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature.mask.data()));
+				const auto pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature.pattern.data()));
+
+				return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(block, mask), pattern)) == 0xFFFF;
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+				const auto block = vld1q_u8(bytes.data());
+				const auto equal = vceqq_u8(vandq_u8(block, vld1q_u8(signature.mask.data())), vld1q_u8(signature.pattern.data()));
+
+				return vminvq_u8(equal) == 0xFF;
+#endif
+			}
+
+			for (std::size_t index {}; index < window_size; ++index)
+			{
+				if ((bytes[index] & signature.mask[index]) != signature.pattern[index])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// @brief Check the MP4 signature, an 'ftyp' box with brand 'mp4' among the major or compatible brands.
+		[[nodiscard]] constexpr auto is_mp4(const std::span<const std::uint8_t> header) noexcept -> bool
+		{
+			if (header.size() < 12)
+			{
+				return false;
+			}
+
+			const auto box_size = std::uint32_t {header[0]} << 24 | std::uint32_t {header[1]} << 16 | std::uint32_t {header[2]} << 8 | header[3];
+
+			if (header.size() < box_size or box_size % 4 != 0)
+			{
+				return false;
+			}
+
+			auto equals = [&](const std::size_t offset, const std::string_view text) noexcept
+			{ return std::ranges::equal(header.subspan(offset, text.size()), text, {}, {}, [](const char c) { return static_cast<std::uint8_t>(c); }); };
+
+			if (not equals(4, "ftyp"))
+			{
+				return false;
+			}
+
+			if (equals(8, "mp4"))
+			{
+				return true;
+			}
+
+			for (std::size_t offset {16}; offset + 3 <= box_size; offset += 4)
+			{
+				if (equals(offset, "mp4"))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/// @brief Check the WebM signature, an EBML header whose DocType element is 'webm'.
+		[[nodiscard]] constexpr auto is_webm(const std::span<const std::uint8_t> header) noexcept -> bool
+		{
+			if (header.size() < 4 or header[0] != 0x1A or header[1] != 0x45 or header[2] != 0xDF or header[3] != 0xA3)
+			{
+				return false;
+			}
+
+			for (std::size_t index {4}; index + 1 < header.size() and index < 38; ++index)
+			{
+				if (header[index] == 0x42 and header[index + 1] == 0x82)
+				{
+					index += 2;
+
+					if (index >= header.size())
+					{
+						return false;
+					}
+
+					/* Element size is a variable length integer, its length given by the leading zero bits. */
+					std::size_t size {1};
+
+					for (unsigned mask {0x80}; size < 8 and size < header.size() and (header[index] & mask) == 0; mask >>= 1)
+					{
+						++size;
+					}
+
+					index += size;
+
+					/* As the standard, which requires 'iter < length - 4' before matching. */
+					if (index + 4 >= header.size())
+					{
+						return false;
+					}
+
+					auto padded = index;
+
+					while (padded + 4 < header.size() and header[padded] == 0x00)
+					{
+						++padded;
+					}
+
+					if (header[padded] == 'w' and header[padded + 1] == 'e' and header[padded + 2] == 'b' and header[padded + 3] == 'm')
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		/// @brief Test for binary data bytes, control characters other than tabulation, new line, form feed, carriage return and escape.
+		/// Vectorised where supported.
+		[[nodiscard]] constexpr auto contains_binary(const std::span<const std::uint8_t> header) noexcept -> bool
+		{
+			constexpr std::uint32_t binary {~std::uint32_t {(1u << 0x09) | (1u << 0x0A) | (1u << 0x0C) | (1u << 0x0D) | (1u << 0x1B)}};
+
+			std::size_t index {};
+
+			if !consteval
+			{
+#if defined(__SSE2__)
+				for (; index + 16 <= header.size(); index += 16)
+				{
+					const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(header.data() + index));
+					const auto control = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1F)), block);
+					const auto allowed = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x09)), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x0A))),
+													  _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x0C)), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x0D))),
+																   _mm_cmpeq_epi8(block, _mm_set1_epi8(0x1B))));
+
+					if (_mm_movemask_epi8(_mm_andnot_si128(allowed, control)) != 0)
+					{
+						return true;
+					}
+				}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+				for (; index + 16 <= header.size(); index += 16)
+				{
+					const auto block = vld1q_u8(header.data() + index);
+					const auto allowed = vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8(0x09)), vceqq_u8(block, vdupq_n_u8(0x0A))),
+												  vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8(0x0C)), vceqq_u8(block, vdupq_n_u8(0x0D))),
+														   vceqq_u8(block, vdupq_n_u8(0x1B))));
+
+					if (vmaxvq_u8(vbicq_u8(vcleq_u8(block, vdupq_n_u8(0x1F)), allowed)) != 0)
+					{
+						return true;
+					}
+				}
+#endif
+			}
+
+			for (; index < header.size(); ++index)
+			{
+				if (header[index] < 32 and (binary >> header[index] & 1) != 0)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	/// @brief Identify media type of a resource without trustworthy Content-Type, by the WHATWG rules for an unknown MIME type.
+	/// @brief Only the signatures whose first byte can match are compared, each with a single masked vector compare.
+	/// @param resource Bytes of resource, only the first 512 are inspected.
+	/// @param scriptable The sniff-scriptable flag, whether HTML, XML and PDF may be identified.
+	/// @return View of static storage, 'text/plain' or 'application/octet-stream' if no signature match. Use
+	/// `media_type_registry::find_well_known` for its interned identifier.
+	[[nodiscard]] constexpr auto sniff(const std::span<const std::byte> resource, const bool scriptable = true) noexcept -> media_type_view
+	{
+		/* Zero past the header, so a window at any offset within it never reads outside the storage. */
+		std::array<std::uint8_t, sniffing::header_size + sniffing::window_size> storage {};
+		const auto header = std::span {storage}.first(std::min(resource.size(), sniffing::header_size));
+		std::ranges::transform(resource.first(header.size()), header.begin(),
+							   [](const std::byte byte) noexcept { return std::to_integer<std::uint8_t>(byte); });
+
+		const auto skipped = static_cast<std::size_t>(
+			std::ranges::find_if_not(header, [](const std::uint8_t byte) noexcept { return ascii::is_whitespace(static_cast<char>(byte)); })
+			- header.begin());
+
+		sniffing::window start {};
+		sniffing::window after_whitespace {};
+		std::ranges::copy_n(storage.begin(), sniffing::window_size, start.begin());
+		std::ranges::copy_n(storage.begin() + static_cast<std::ptrdiff_t>(skipped), sniffing::window_size, after_whitespace.begin());
+
+		auto remaining = sniffing::candidates[start[0]] & ~sniffing::skipping_whitespace;
+		remaining |= sniffing::candidates[after_whitespace[0]] & sniffing::skipping_whitespace;
+
+		if (not scriptable)
+		{
+			remaining &= ~sniffing::scriptable_signatures;
+		}
+
+		for (; remaining != 0; remaining &= remaining - 1)
+		{
+			const auto& signature = sniffing::signatures[static_cast<std::size_t>(std::countr_zero(remaining))];
+			const auto& bytes = signature.skip_whitespace ? after_whitespace : start;
+			const auto available = header.size() - (signature.skip_whitespace ? skipped : 0);
+
+			if (available < signature.length + signature.tag_terminated or not sniffing::matches(bytes, signature))
+			{
+				continue;
+			}
+
+			if (signature.tag_terminated and bytes[signature.length] != ' ' and bytes[signature.length] != '>')
+			{
+				continue;
+			}
+
+			/* Archive signatures come after the MP4 and WebM checks, but no archive pattern can match either. */
+			return signature.type;
+		}
+
+		if (sniffing::is_mp4(header))
+		{
+			return "video/mp4";
+		}
+
+		if (sniffing::is_webm(header))
+		{
+			return "video/webm";
+		}
+
+		if (sniffing::contains_binary(header))
+		{
+			return "application/octet-stream";
+		}
+		else
+		{
+			return "text/plain";
+		}
+	}
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief Non-owning media type as defined by RFC 6838, parsed in place over a caller-owned buffer.
+	/// @brief The buffer is never copied nor rewritten, so accessors return the original casing and comparisons are case-insensitive.
+	/// @brief The viewed buffer must outlive the view.
+	class media_type_view
+	{
+		std::string_view value;
+
+		/// @brief Validated parameters after the ';' terminating the media type, as written.
+		std::string_view parameter_text;
+
+		/// @brief Same layout as `media_type`, relative to the start of `value`.
+		media_type::character_offset offset {};
+
+		[[nodiscard]] constexpr media_type_view(const std::string_view value,
+												const std::string_view parameter_text,
+												const media_type::character_offset offset) noexcept :
+			value {value}, parameter_text {parameter_text}, offset {offset}
+		{ }
+
+		[[nodiscard]] constexpr static auto equals_ignore_case(const std::string_view left, const std::string_view right) noexcept -> bool
+		{ return media_type::equals_ignore_case(left, right); }
+
+	  public:
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value', must outlive the view.
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr media_type_view(const std::string_view type)
+		{
+			if (const auto result = try_parse(type); result)
+			{
+				*this = *result;
+			}
+			else
+			{
+				throw media_type::parsing_error {result.error()};
+			}
+		}
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Null-terminated media type in format 'type/tree.subtype+suffix;name=value', must outlive the view.
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr media_type_view(const char* const type) : media_type_view {std::string_view {type}} { }
+
+		/// @brief Media type as defined by RFC 6838. Parameters as defined by RFC 9110.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value', must outlive the view.
+		/// @exception media_type::parsing_error If string fail to parse.
+		[[nodiscard]] constexpr media_type_view(const std::string& type) : media_type_view {std::string_view {type}} { }
+
+		/// @brief Viewing a temporary string would dangle.
+		media_type_view(std::string&&) = delete;
+
+		/// @brief View of an owning media type. Does not parse again.
+		/// @param type Media type using any allocator, must outlive the view.
+		template<typename Allocator>
+		[[nodiscard]] constexpr media_type_view(const basic_media_type<Allocator>& type) noexcept :
+			value {type.value}, parameter_text {type.parameter_text}, offset {type.offset}
+		{ }
+
+		/// @brief Viewing a temporary media type would dangle.
+		template<typename Allocator>
+		media_type_view(basic_media_type<Allocator>&&) = delete;
+
+		/// @brief Non-throwing alternative to the constructors, for input that is expected to be malformed now and then.
+		/// @param type Media type in format 'type/tree.subtype+suffix;name=value', must outlive the view.
+		/// @return Media type view, or the reason the string fail to parse, a malformed parameter included.
+		[[nodiscard]] constexpr static auto try_parse(const std::string_view type) noexcept -> std::expected<media_type_view, media_type::error>
+		{
+			return stats::measure([&]() -> std::expected<media_type_view, media_type::error>
+			{
+				media_type::scanner scanner {};
+
+				for (const auto character : type)
+				{
+					if (not scanner.consume(character))
+					{
+						break;
+					}
+				}
+
+				if (const auto offset = scanner.finish(); offset)
+				{
+					std::string_view parameters {};
+
+					if (scanner.parameters() != std::string_view::npos)
+					{
+						parameters = type.substr(scanner.parameters());
+
+						if (const auto result = media_type::parse_parameters(parameters, [](auto&&...) noexcept { return true; }); not result)
+						{
+							return std::unexpected {result.error()};
+						}
+					}
+
+					return media_type_view {type.substr(0, scanner.size()), parameters, *offset};
+				}
+				else
+				{
+					return std::unexpected {offset.error()};
+				}
+			});
+		}
+
+		[[nodiscard]] constexpr auto operator==(const media_type_view& other) const noexcept -> bool
+		{ return equals_ignore_case(value, other.value); };
+		template<typename Allocator>
+		[[nodiscard]] constexpr auto operator==(const basic_media_type<Allocator>& other) const noexcept -> bool
+		{ return equals_ignore_case(value, other.string()); };
+		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool
+		{ return equals_ignore_case(value, other); };
+		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool
+		{ return equals_ignore_case(value, other); };
+
+		/// @brief Orders as `media_type`, by component ignoring case, so views and owning types sort together.
+		[[nodiscard]] constexpr auto operator<=>(const media_type_view& other) const noexcept -> std::weak_ordering
+		{ return media_type::compare_components(value, offset, other.value, other.offset); };
+		template<typename Allocator>
+		[[nodiscard]] constexpr auto operator<=>(const basic_media_type<Allocator>& other) const noexcept -> std::weak_ordering
+		{ return media_type::compare_components(value, offset, other.value, other.offset); };
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix', in original casing.
+		[[nodiscard]] constexpr auto string() const noexcept -> std::string_view { return value; }
+
+		/// @brief Get top-level type, in original casing.
+		[[nodiscard]] constexpr auto type() const noexcept -> std::string_view { return value.substr(0, offset.after_slash - 1); }
+
+		/// @brief Get registration tree, in original casing.
+		[[nodiscard]] constexpr auto tree() const noexcept -> std::string_view
+		{ return value.substr(offset.after_slash, offset.after_possible_first_dot); }
+
+		/// @brief Get subtype, in original casing.
+		[[nodiscard]] constexpr auto subtype() const noexcept -> std::string_view
+		{
+			const auto start = static_cast<std::size_t>(offset.after_slash) + static_cast<std::size_t>(offset.after_possible_first_dot);
+
+			if (offset.possible_last_plus)
+			{
+				return value.substr(start, offset.possible_last_plus);
+			}
+			else
+			{
+				return value.substr(start);
+			}
+		}
+
+		/// @brief Get structured type name suffix, in original casing.
+		[[nodiscard]] constexpr auto suffix() const noexcept -> std::string_view
+		{
+			if (offset.possible_last_plus)
+			{
+				const auto start = static_cast<std::size_t>(offset.after_slash) + static_cast<std::size_t>(offset.after_possible_first_dot)
+								   + static_cast<std::size_t>(offset.possible_last_plus);
+				return value.substr(start);
+			}
+			else
+			{
+				return {};
+			}
+		}
+
+		/// @brief Check if media type is in standards tree.
+		/// @return True if media type is in standards tree.
+		[[nodiscard]] constexpr auto in_standards_tree() const noexcept -> bool { return not offset.after_possible_first_dot; }
+
+		/// @brief Get structured syntax suffix. Classified on every call, as the view stores nothing but offsets.
+		[[nodiscard]] constexpr auto structured_suffix() const noexcept -> common_good::structured_suffix
+		{ return media_type::classify_suffix(suffix()); }
+
+		/// @brief Get top-level type. Classified on every call, as the view stores nothing but offsets.
+		[[nodiscard]] constexpr auto top_level_type() const noexcept -> common_good::top_level_type
+		{ return media_type::classify_top_level_type(type()); }
+
+		/// @brief Get preferred file extension, parameters not considered.
+		/// @return Extension without leading '.', or nothing if there is none. Defined in 'media_type_extension.hpp'.
+		[[nodiscard]] constexpr auto preferred_extension() const noexcept -> std::optional<std::string_view>;
+
+		/// @brief Get value of parameter, in original casing. Parameters are parsed again on every call, without allocation.
+		/// @param name Parameter name, compared case-insensitively.
+		/// @return Value of first parameter with name, or nothing if there is none.
+		[[nodiscard]] constexpr auto parameter(const std::string_view name) const noexcept -> std::optional<std::string_view>
+		{
+			std::optional<std::string_view> result {};
+
+			auto visitor = [&](const std::string_view parameter_name, const std::string_view parameter_value, bool) noexcept
+			{
+				if (equals_ignore_case(parameter_name, name))
+				{
+					result = parameter_value;
+				}
+
+				return not result;
+			};
+
+			static_cast<void>(media_type::parse_parameters(parameter_text, visitor));
+			return result;
+		}
+
+		/// @brief Get all parameters in order, in original casing.
+		[[nodiscard]] constexpr auto parameters() const -> media_type::parameter_list
+		{
+			media_type::parameter_list list {};
+
+			auto visitor = [&](const std::string_view name, const std::string_view value, bool)
+			{
+				list.push_back({name, value});
+				return true;
+			};
+
+			static_cast<void>(media_type::parse_parameters(parameter_text, visitor));
+			return list;
+		}
+
+		/// @brief Get parameters as written, without the leading ';'.
+		[[nodiscard]] constexpr auto parameters_string() const noexcept -> std::string_view { return parameter_text; }
+
+		template<typename>
+		friend class basic_media_type;
+		friend class compact_media_type;
+		friend struct media_type_columns;
+		friend class media_type_cache;
+		friend class multipart_parser;
+		template<std::size_t>
+		friend class fixed_media_type;
+	};
+
+	template<typename Allocator>
+	constexpr basic_media_type<Allocator>::basic_media_type(const media_type_view& view, const Allocator& allocator) :
+		value {view.value, allocator}, offset {view.offset}, parameter_text {allocator}, parameter_offsets {offset_allocator {allocator}}
+	{
+		ascii::to_lowercase_in_place(value);
+		derive();
+
+		/* The view has already validated its parameters. */
+		static_cast<void>(store_parameters(view.parameter_text));
+	}
+}
+
+template<>
+struct std::hash<common_good::media_type_view>
+{
+	[[nodiscard]] constexpr auto operator()(const common_good::media_type_view& type) const noexcept -> std::size_t
+	{ return common_good::media_type::hash_ignore_case(type.string()); }
+};
+
+template<>
+struct std::formatter<common_good::media_type_view> : common_good::media_type_formatter
+{
+	constexpr auto format(const common_good::media_type_view& media_type, auto&& context) const
+	{
+		return write({media_type.string(), media_type.type(), media_type.tree(), media_type.subtype(), media_type.suffix(),
+					  media_type.parameters_string(), false},
+					 context);
+	}
+};
+
+/* `preferred_extension()` is declared above, so its definition follows here. */
+#include "media_type_extension.hpp"
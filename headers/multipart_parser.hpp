@@ -0,0 +1,596 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace common_good
+{
+	/// @brief Part of a multipart body as passed to the visitor of `multipart_parser::feed`.
+	/// @brief Views into the parser, valid during the call only.
+	class multipart_part
+	{
+		friend class multipart_parser;
+
+		std::string_view header_text;
+		std::optional<media_type_view> type;
+		std::size_t number {};
+
+		[[nodiscard]] constexpr multipart_part(const std::string_view header_text,
+											   const std::optional<media_type_view> type,
+											   const std::size_t number) noexcept :
+			header_text {header_text}, type {type}, number {number}
+		{ }
+
+	  public:
+		/// @brief Get header lines as received, separated by line breaks and without the empty line ending them.
+		[[nodiscard]] constexpr auto headers() const noexcept -> std::string_view { return header_text; }
+
+		/// @brief Get value of header, without surrounding blanks.
+		/// @param name Header name, compared case-insensitively.
+		/// @return Value of first header with name, or nothing if there is none. Folded continuation lines are not included.
+		[[nodiscard]] constexpr auto header(const std::string_view name) const noexcept -> std::optional<std::string_view>
+		{
+			for (auto text = header_text; not text.empty();)
+			{
+				const auto end = text.find('\n');
+				auto line = text.substr(0, end);
+				text = end == std::string_view::npos ? std::string_view {} : text.substr(end + 1);
+
+				if (line.ends_with('\r'))
+				{
+					line.remove_suffix(1);
+				}
+
+				if (const auto colon = line.find(':'); colon != std::string_view::npos and ascii::equals_ignore_case(line.substr(0, colon), name))
+				{
+					auto value = line.substr(colon + 1);
+
+					while (not value.empty() and ascii::is_blank(value.front()))
+					{
+						value.remove_prefix(1);
+					}
+
+					while (not value.empty() and ascii::is_blank(value.back()))
+					{
+						value.remove_suffix(1);
+					}
+
+					return value;
+				}
+			}
+
+			return std::nullopt;
+		}
+
+		/// @brief Get media type of part, parsed once when its headers are complete.
+		/// @return Media type, or nothing if the part has no valid 'Content-Type' header. RFC 2046 then defaults to
+		/// 'text/plain; charset=us-ascii', which is left to the caller.
+		[[nodiscard]] constexpr auto content_type() const noexcept -> std::optional<media_type_view> { return type; }
+
+		/// @brief Get zero-based position of part within the body.
+		[[nodiscard]] constexpr auto index() const noexcept -> std::size_t { return number; }
+	};
+
+	/// @brief Incremental splitter of multipart bodies as defined by RFC 2046, such as 'multipart/form-data' and 'multipart/mixed'.
+	/// @brief Body chunks are passed to `feed` as they arrive, and the data of each part is handed to the visitor as views into
+	/// those chunks. Only header lines, and bytes at the end of a chunk which may begin a delimiter, are copied.
+	/// @brief The delimiter is searched for by its first and last byte a block at a time where vectorised, and compared in full
+	/// only where both match.
+	class multipart_parser
+	{
+	  public:
+		/// @brief Reason a body or its media type fail to parse.
+		enum class error : unsigned char
+		{
+			not_multipart,
+			missing_boundary,
+			boundary_length,
+			boundary_character,
+			delimiter_padding,
+			header_size,
+			header_syntax,
+			truncated,
+		};
+
+		/// @brief Get description of error.
+		[[nodiscard]] constexpr static auto message(const error code) noexcept -> const char*
+		{
+			switch (code)
+			{
+				case error::not_multipart: return "multipart: media type: top-level type required to be 'multipart'";
+				case error::missing_boundary: return "multipart: media type: missing parameter 'boundary'";
+				case error::boundary_length: return "multipart: boundary: lenght required to be [1..70] characters";
+				case error::boundary_character: return "multipart: boundary: containing non-valid characters";
+				case error::delimiter_padding: return "multipart: delimiter: followed by other than blanks and line break";
+				case error::header_size: return "multipart: headers: larger than the limit";
+				case error::header_syntax: return "multipart: headers: line without name and ':'";
+				case error::truncated: return "multipart: body: ended before the close delimiter";
+			}
+
+			return "multipart: unknown error";
+		}
+
+		/// @brief Exception thrown on parsing error.
+		class parsing_error : public std::invalid_argument
+		{
+			error reason;
+
+		  public:
+			[[nodiscard]] explicit parsing_error(const error code) noexcept : std::invalid_argument {message(code)}, reason {code} { };
+
+			/// @brief Get the reason the body fail to parse.
+			[[nodiscard]] auto code() const noexcept -> error { return reason; }
+		};
+
+	  private:
+		/// @brief Position within the RFC 2046 body grammar.
+		enum class state : unsigned char
+		{
+			preamble,
+			delimiter_end,
+			padding,
+			line_feed,
+			close_dash,
+			headers,
+			body,
+			epilogue,
+		};
+
+		/// @brief Location of a valid 'Content-Type' within `header_text`, so the view survives the parser being moved.
+		struct content_type_location
+		{
+			std::size_t value;
+			std::size_t value_size;
+			std::size_t parameters;
+			std::size_t parameters_size;
+			media_type::character_offset offset;
+		};
+
+		/// @brief Line break, "--" and boundary.
+		std::string delimiter;
+
+		/// @brief Bytes at the end of the previous chunk that begin the delimiter, held back until the next chunk tells.
+		std::string held;
+
+		std::string header_text;
+		std::size_t header_limit;
+		std::optional<content_type_location> type;
+		std::size_t part_count {};
+
+		/// @brief The body is searched as if preceded by a line break, so it may begin with the first delimiter.
+		state current {state::preamble};
+
+		std::optional<error> failure {};
+
+		/// @brief Validate boundary as RFC 2046 'bchars', not ending in space.
+		[[nodiscard]] constexpr static auto validate_boundary(const media_type_view type) noexcept -> std::expected<std::string_view, error>
+		{
+			if (type.top_level_type() != top_level_type::multipart)
+			{
+				return std::unexpected {error::not_multipart};
+			}
+
+			const auto boundary = type.parameter("boundary");
+
+			if (not boundary)
+			{
+				return std::unexpected {error::missing_boundary};
+			}
+
+			if (boundary->empty() or boundary->size() > 70)
+			{
+				return std::unexpected {error::boundary_length};
+			}
+
+			for (const auto character : *boundary)
+			{
+				if (not ascii::is_alphanumeric(character) and std::string_view {"'()+_,-./:=? "}.find(character) == std::string_view::npos)
+				{
+					return std::unexpected {error::boundary_character};
+				}
+			}
+
+			if (boundary->back() == ' ')
+			{
+				return std::unexpected {error::boundary_character};
+			}
+
+			return *boundary;
+		}
+
+		/// @brief Find first occurrence of delimiter, vectorised where supported.
+		/// @param text Characters to search.
+		/// @param delimiter Characters to find, at least two.
+		/// @return Offset of delimiter, or `npos` if there is none.
+		[[nodiscard]] constexpr static auto find(const std::string_view text, const std::string_view delimiter) noexcept -> std::size_t
+		{
+			std::size_t index {};
+
+			if !consteval
+			{
+#if defined(__SSE2__) or defined(__AVX2__) or (defined(__ARM_NEON) and defined(__aarch64__))
+				const auto last = delimiter.size() - 1;
+
+				/* Candidates are compared again from the second byte, as the first and last are known to match. */
+				const auto matches = [&](const std::size_t position) noexcept
+				{ return std::memcmp(text.data() + position + 1, delimiter.data() + 1, last - 1) == 0; };
+
+#if defined(__AVX2__)
+				const auto first_256 = _mm256_set1_epi8(delimiter.front());
+				const auto last_256 = _mm256_set1_epi8(delimiter.back());
+
+				for (; index + last + 32 <= text.size(); index += 32)
+				{
+					const auto front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + index));
+					const auto back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + index + last));
+
+					for (auto candidates = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+							 _mm256_and_si256(_mm256_cmpeq_epi8(front, first_256), _mm256_cmpeq_epi8(back, last_256))));
+						 candidates != 0; candidates &= candidates - 1)
+					{
+						if (const auto position = index + static_cast<std::size_t>(std::countr_zero(candidates)); matches(position))
+						{
+							return position;
+						}
+					}
+				}
+#endif
+#if defined(__SSE2__)
+				const auto first_128 = _mm_set1_epi8(delimiter.front());
+				const auto last_128 = _mm_set1_epi8(delimiter.back());
+
+				for (; index + last + 16 <= text.size(); index += 16)
+				{
+					const auto front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + index));
+					const auto back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + index + last));
+
+					for (auto candidates = static_cast<std::uint32_t>(
+							 _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(front, first_128), _mm_cmpeq_epi8(back, last_128))));
+						 candidates != 0; candidates &= candidates - 1)
+					{
+						if (const auto position = index + static_cast<std::size_t>(std::countr_zero(candidates)); matches(position))
+						{
+							return position;
+						}
+					}
+				}
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+				const auto first_128 = vdupq_n_u8(static_cast<std::uint8_t>(delimiter.front()));
+				const auto last_128 = vdupq_n_u8(static_cast<std::uint8_t>(delimiter.back()));
+
+				/* No movemask, so blocks with any candidate are checked byte by byte. */
+				for (; index + last + 16 <= text.size(); index += 16)
+				{
+					const auto front = vld1q_u8(reinterpret_cast<const std::uint8_t*>(text.data() + index));
+					const auto back = vld1q_u8(reinterpret_cast<const std::uint8_t*>(text.data() + index + last));
+
+					if (vmaxvq_u8(vandq_u8(vceqq_u8(front, first_128), vceqq_u8(back, last_128))) == 0)
+					{
+						continue;
+					}
+
+					for (std::size_t position {index}; position < index + 16; ++position)
+					{
+						if (text[position] == delimiter.front() and text[position + last] == delimiter.back() and matches(position))
+						{
+							return position;
+						}
+					}
+				}
+#endif
+#endif
+			}
+
+			return text.find(delimiter, index);
+		}
+
+		/// @brief Get current part, with views into the header text.
+		[[nodiscard]] constexpr auto part() const noexcept -> multipart_part
+		{
+			std::optional<media_type_view> view {};
+
+			if (type)
+			{
+				const std::string_view text {header_text};
+				view = media_type_view {text.substr(type->value, type->value_size), text.substr(type->parameters, type->parameters_size),
+										type->offset};
+			}
+
+			return multipart_part {header_text, view, part_count - 1};
+		}
+
+		/// @brief Pass data of current part to visitor, nothing of the preamble.
+		template<typename Visitor>
+		constexpr void emit(Visitor& visitor, const std::string_view data, const bool complete)
+		{
+			if (current == state::body and (complete or not data.empty()))
+			{
+				visitor(part(), data, complete);
+			}
+		}
+
+		/// @brief Part or preamble ended at a delimiter.
+		template<typename Visitor>
+		constexpr void on_delimiter(Visitor& visitor, const std::string_view data)
+		{
+			emit(visitor, data, true);
+			current = state::delimiter_end;
+		}
+
+		/// @brief Search chunk for delimiter, resolving first whether bytes held back from the previous chunk begin one.
+		/// @return Rest of chunk after the delimiter, or empty if chunk is consumed.
+		template<typename Visitor>
+		constexpr auto scan(std::string_view chunk, Visitor& visitor) -> std::string_view
+		{
+			for (std::size_t start {}; start < held.size(); ++start)
+			{
+				const auto pending = std::string_view {held}.substr(start);
+
+				if (not delimiter.starts_with(pending))
+				{
+					continue;
+				}
+
+				const auto needed = delimiter.size() - pending.size();
+				const auto available = chunk.substr(0, needed);
+
+				if (available != std::string_view {delimiter}.substr(pending.size(), available.size()))
+				{
+					continue;
+				}
+
+				if (available.size() == needed)
+				{
+					on_delimiter(visitor, std::string_view {held}.substr(0, start));
+					held.clear();
+					return chunk.substr(needed);
+				}
+
+				emit(visitor, std::string_view {held}.substr(0, start), false);
+				held.erase(0, start);
+				held.append(chunk);
+				return {};
+			}
+
+			emit(visitor, held, false);
+			held.clear();
+
+			if (const auto position = find(chunk, delimiter); position != std::string_view::npos)
+			{
+				on_delimiter(visitor, chunk.substr(0, position));
+				return chunk.substr(position + delimiter.size());
+			}
+
+			/* The longest end of chunk that begins the delimiter, which always begins with a line break. */
+			auto tail = chunk.size();
+
+			for (auto position = chunk.size() > delimiter.size() ? chunk.size() - delimiter.size() + 1 : 0;
+				 (position = chunk.find(delimiter.front(), position)) != std::string_view::npos; ++position)
+			{
+				if (delimiter.starts_with(chunk.substr(position)))
+				{
+					tail = position;
+					break;
+				}
+			}
+
+			emit(visitor, chunk.substr(0, tail), false);
+			held.assign(chunk.substr(tail));
+			return {};
+		}
+
+		/// @brief Accumulate header lines until the empty line ending them.
+		/// @return Rest of chunk after the headers, or empty if chunk is consumed.
+		constexpr auto consume_headers(std::string_view chunk) -> std::string_view
+		{
+			while (not chunk.empty())
+			{
+				const auto end = chunk.find('\n');
+				const auto previous = header_text.rfind('\n');
+				const auto line_start = previous == std::string::npos ? 0 : previous + 1;
+
+				header_text.append(chunk.substr(0, end == std::string_view::npos ? chunk.size() : end + 1));
+				chunk = end == std::string_view::npos ? std::string_view {} : chunk.substr(end + 1);
+
+				if (header_text.size() > header_limit)
+				{
+					failure = error::header_size;
+					return {};
+				}
+
+				if (end == std::string_view::npos)
+				{
+					break;
+				}
+
+				if (const auto line = std::string_view {header_text}.substr(line_start); line == "\r\n" or line == "\n")
+				{
+					header_text.resize(line_start);
+					finish_headers();
+					return chunk;
+				}
+			}
+
+			return {};
+		}
+
+		/// @brief Validate header lines and locate 'Content-Type'.
+		constexpr void finish_headers()
+		{
+			while (header_text.ends_with('\n') or header_text.ends_with('\r'))
+			{
+				header_text.pop_back();
+			}
+
+			for (std::string_view text {header_text}; not text.empty();)
+			{
+				const auto end = text.find('\n');
+				const auto line = text.substr(0, end);
+				text = end == std::string_view::npos ? std::string_view {} : text.substr(end + 1);
+
+				/* Folded continuation of the previous line. */
+				if (not line.empty() and ascii::is_blank(line.front()) and line.data() != header_text.data())
+				{
+					continue;
+				}
+
+				const auto colon = line.find(':');
+
+				if (colon == 0 or colon == std::string_view::npos
+					or not std::ranges::all_of(line.substr(0, colon),
+											   [](const char character) noexcept { return ascii::matches(character, ascii::character_class::token); }))
+				{
+					failure = error::header_syntax;
+					return;
+				}
+			}
+
+			current = state::body;
+			++part_count;
+			type.reset();
+
+			const auto found = multipart_part {header_text, std::nullopt, 0}.header("content-type");
+
+			if (not found)
+			{
+				return;
+			}
+
+			if (const auto view = media_type_view::try_parse(*found); view)
+			{
+				const auto base = std::string_view {header_text}.data();
+				type = content_type_location {static_cast<std::size_t>(view->value.data() - base), view->value.size(),
+											  view->parameter_text.empty() ? 0 : static_cast<std::size_t>(view->parameter_text.data() - base),
+											  view->parameter_text.size(), view->offset};
+			}
+		}
+
+	  public:
+		/// @brief Parser of body of multipart media type.
+		/// @param type Media type of body, such as 'multipart/form-data; boundary=...'. Need not outlive the parser.
+		/// @param header_limit Largest header block of each part accepted, in bytes.
+		/// @exception multipart_parser::parsing_error If type is not multipart or has no valid boundary.
+		[[nodiscard]] explicit multipart_parser(const media_type_view type, const std::size_t header_limit = 8192) :
+			header_limit {header_limit}
+		{
+			const auto boundary = validate_boundary(type);
+
+			if (not boundary)
+			{
+				throw parsing_error {boundary.error()};
+			}
+
+			delimiter.append("\r\n--").append(*boundary);
+			held.assign("\r\n");
+		}
+
+		/// @brief Consume next chunk of body, passing the data of each part to visitor as it is found.
+		/// @brief Visitor is called as `visitor(const multipart_part& part, std::string_view data, bool complete)`, any number of
+		/// times with more data of a part and exactly once with complete set as the part ends. Data views into chunk, or into the
+		/// parser for bytes held back from the previous chunk, and is valid during the call only.
+		/// @param chunk Bytes following those of previous chunks, need not outlive the call.
+		/// @param visitor Callable receiving data of parts.
+		/// @return False if body is known to be invalid, further chunks are then ignored.
+		template<typename Visitor>
+		constexpr auto feed(std::string_view chunk, Visitor&& visitor) -> bool
+		{
+			while (not failure and not chunk.empty())
+			{
+				switch (current)
+				{
+					case state::preamble:
+					case state::body: chunk = scan(chunk, visitor); break;
+
+					case state::headers: chunk = consume_headers(chunk); break;
+
+					case state::delimiter_end:
+					case state::padding:
+					{
+						const auto character = chunk.front();
+						chunk.remove_prefix(1);
+
+						if (character == '-' and current == state::delimiter_end)
+						{
+							current = state::close_dash;
+						}
+						else if (character == '\r')
+						{
+							current = state::line_feed;
+						}
+						else if (ascii::is_blank(character))
+						{
+							current = state::padding;
+						}
+						else
+						{
+							failure = error::delimiter_padding;
+						}
+
+						break;
+					}
+
+					case state::line_feed:
+						if (chunk.front() != '\n')
+						{
+							failure = error::delimiter_padding;
+							break;
+						}
+
+						chunk.remove_prefix(1);
+						header_text.clear();
+						current = state::headers;
+						break;
+
+					case state::close_dash:
+						if (chunk.front() != '-')
+						{
+							failure = error::delimiter_padding;
+							break;
+						}
+
+						chunk.remove_prefix(1);
+						current = state::epilogue;
+						break;
+
+					/* Anything after the close delimiter is ignored. */
+					case state::epilogue: return true;
+				}
+			}
+
+			return not failure;
+		}
+
+		/// @brief Validate that the body ended with the close delimiter.
+		/// @return Nothing, or the first error encountered.
+		[[nodiscard]] constexpr auto finish() const -> std::expected<void, error>
+		{
+			if (failure)
+			{
+				return std::unexpected {*failure};
+			}
+
+			if (current != state::epilogue)
+			{
+				return std::unexpected {error::truncated};
+			}
+
+			return {};
+		}
+
+		/// @brief Get number of parts whose headers have been read, complete or not.
+		[[nodiscard]] constexpr auto parts() const noexcept -> std::size_t { return part_count; }
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace common_good
+{
+	/// @brief Contiguous container storing up to `Capacity` elements inline, spilling all elements to the heap beyond that.
+	/// @tparam Type Element type, required to be copyable and default constructible as inline storage is always constructed.
+	/// @tparam Capacity Number of elements stored without allocation.
+	/// @tparam Allocator Allocator of the heap elements.
+	template<typename Type, std::size_t Capacity, typename Allocator = std::allocator<Type>>
+		requires std::copyable<Type> and std::default_initializable<Type>
+	class small_vector
+	{
+		std::array<Type, Capacity> inline_elements {};
+		std::vector<Type, Allocator> heap_elements {};
+		std::size_t count {};
+
+		[[nodiscard]] constexpr auto spilled() const noexcept -> bool { return count > Capacity; }
+
+	  public:
+		using value_type = Type;
+		using allocator_type = Allocator;
+		using iterator = Type*;
+		using const_iterator = const Type*;
+
+		[[nodiscard]] constexpr small_vector() noexcept = default;
+
+		[[nodiscard]] constexpr explicit small_vector(const Allocator& allocator) noexcept : heap_elements {allocator} { }
+
+		[[nodiscard]] constexpr small_vector(const small_vector& other, const Allocator& allocator) :
+			inline_elements {other.inline_elements}, heap_elements {other.heap_elements, allocator}, count {other.count}
+		{ }
+
+		[[nodiscard]] constexpr small_vector(small_vector&& other, const Allocator& allocator) :
+			inline_elements {other.inline_elements}, heap_elements {std::move(other.heap_elements), allocator}, count {other.count}
+		{ }
+
+		/// @brief Append element, moving every element to the heap when inline capacity is exceeded.
+		/// @param element Element to append.
+		constexpr void push_back(const Type& element)
+		{
+			if (count < Capacity)
+			{
+				inline_elements[count] = element;
+			}
+			else
+			{
+				if (count == Capacity)
+				{
+					heap_elements.reserve(Capacity * 2 + 1);
+					heap_elements.assign(inline_elements.begin(), inline_elements.end());
+				}
+
+				heap_elements.push_back(element);
+			}
+
+			++count;
+		}
+
+		/// @brief Remove all elements, keeping any heap allocation for reuse.
+		constexpr void clear() noexcept
+		{
+			heap_elements.clear();
+			count = 0;
+		}
+
+		[[nodiscard]] constexpr auto data() noexcept -> Type* { return spilled() ? heap_elements.data() : inline_elements.data(); }
+		[[nodiscard]] constexpr auto data() const noexcept -> const Type*
+		{ return spilled() ? heap_elements.data() : inline_elements.data(); }
+
+		[[nodiscard]] constexpr auto get_allocator() const noexcept -> Allocator { return heap_elements.get_allocator(); }
+
+		[[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return count; }
+		[[nodiscard]] constexpr auto empty() const noexcept -> bool { return count == 0; }
+
+		/// @brief Check if elements are stored inline, that is without allocation.
+		[[nodiscard]] constexpr auto is_inline() const noexcept -> bool { return not spilled(); }
+
+		[[nodiscard]] constexpr auto begin() noexcept -> iterator { return data(); }
+		[[nodiscard]] constexpr auto end() noexcept -> iterator { return data() + count; }
+		[[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return data(); }
+		[[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return data() + count; }
+
+		[[nodiscard]] constexpr auto operator[](const std::size_t index) noexcept -> Type& { return data()[index]; }
+		[[nodiscard]] constexpr auto operator[](const std::size_t index) const noexcept -> const Type& { return data()[index]; }
+
+		[[nodiscard]] constexpr operator std::span<Type>() noexcept { return {data(), count}; }
+		[[nodiscard]] constexpr operator std::span<const Type>() const noexcept { return {data(), count}; }
+	};
+}
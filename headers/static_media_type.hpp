@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ascii.hpp"
+#include "media_type.hpp"
+#include "media_type_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace common_good
+{
+	/// @brief String literal usable as template argument.
+	/// @tparam Size Number of characters, including the null-terminator.
+	template<std::size_t Size>
+	struct fixed_string
+	{
+		std::array<char, Size> characters {};
+
+		[[nodiscard]] consteval fixed_string(const char (&string)[Size]) noexcept { std::ranges::copy(string, characters.begin()); }
+
+		[[nodiscard]] constexpr auto view() const noexcept -> std::string_view { return {characters.data(), Size - 1}; }
+	};
+
+	/// @brief Media type validated and laid out at compile time, without any storage per object.
+	/// @brief An invalid literal fails to compile. Parameters as defined by RFC 9110.
+	/// @tparam Literal Media type in format 'type/tree.subtype+suffix;name=value'
+	template<fixed_string Literal>
+	class static_media_type
+	{
+		static constexpr auto validated = []
+		{
+			if (const auto result = media_type_view::try_parse(Literal.view()); result)
+			{
+				return *result;
+			}
+			else
+			{
+				throw media_type::parsing_error {result.error()};
+			}
+		}();
+
+		/// @brief Copy of the literal with type, tree, subtype and suffix lowercase, parameters as written.
+		static constexpr auto storage = []
+		{
+			auto storage = Literal.characters;
+			ascii::to_lowercase_in_place(std::span {storage}.first(validated.string().size()));
+			return storage;
+		}();
+
+		static constexpr auto parsed = media_type_view::try_parse({storage.data(), storage.size() - 1}).value();
+
+	  public:
+		/// @brief Get as view, pointing into static storage so it never dangles.
+		[[nodiscard]] constexpr static auto view() noexcept -> media_type_view { return parsed; }
+
+		[[nodiscard]] constexpr operator media_type_view() const noexcept { return parsed; }
+
+		/// @brief Copy into an owning media type. Does not parse again.
+		[[nodiscard]] constexpr explicit operator media_type() const { return media_type {parsed}; }
+
+		template<fixed_string Other>
+		[[nodiscard]] constexpr auto operator==(const static_media_type<Other>&) const noexcept -> bool
+		{ return parsed.string() == static_media_type<Other>::string(); };
+
+		/// @brief Both sides are lowercase, so this is a plain string comparison.
+		[[nodiscard]] constexpr auto operator==(const media_type& other) const noexcept -> bool { return parsed.string() == other.string(); };
+		[[nodiscard]] constexpr auto operator==(const media_type_view& other) const noexcept -> bool { return parsed == other; };
+		[[nodiscard]] constexpr auto operator==(const std::string_view& other) const noexcept -> bool { return parsed == other; };
+		[[nodiscard]] constexpr auto operator==(const char* const other) const noexcept -> bool { return parsed == other; };
+
+		/// @brief Get media type as string in format 'type/tree.subtype+suffix'
+		[[nodiscard]] constexpr static auto string() noexcept -> std::string_view { return parsed.string(); }
+
+		/// @brief Get top-level type.
+		[[nodiscard]] constexpr static auto type() noexcept -> std::string_view { return parsed.type(); }
+
+		/// @brief Get registration tree.
+		[[nodiscard]] constexpr static auto tree() noexcept -> std::string_view { return parsed.tree(); }
+
+		/// @brief Get subtype.
+		[[nodiscard]] constexpr static auto subtype() noexcept -> std::string_view { return parsed.subtype(); }
+
+		/// @brief Get structured type name suffix.
+		[[nodiscard]] constexpr static auto suffix() noexcept -> std::string_view { return parsed.suffix(); }
+
+		/// @brief Check if media type is in standards tree.
+		/// @return True if media type is in standards tree.
+		[[nodiscard]] constexpr static auto in_standards_tree() noexcept -> bool { return parsed.in_standards_tree(); }
+
+		/// @brief Get value of parameter, as written in literal.
+		/// @param name Parameter name, compared case-insensitively.
+		/// @return Value of first parameter with name, or nothing if there is none.
+		[[nodiscard]] constexpr static auto parameter(const std::string_view name) noexcept -> std::optional<std::string_view>
+		{ return parsed.parameter(name); }
+
+		/// @brief Get parameters as written in literal, without the leading ';'.
+		[[nodiscard]] constexpr static auto parameters_string() noexcept -> std::string_view { return parsed.parameters_string(); }
+	};
+
+	inline namespace literals
+	{
+		/// @brief Media type validated and laid out at compile time. Parameters as defined by RFC 9110.
+		/// @tparam Literal Media type in format 'type/tree.subtype+suffix;name=value', an invalid literal fails to compile.
+		template<fixed_string Literal>
+		[[nodiscard]] consteval auto operator""_static_media_type() noexcept
+		{ return static_media_type<Literal> {}; }
+	}
+}
+
+template<common_good::fixed_string Literal>
+struct std::formatter<common_good::static_media_type<Literal>> : common_good::media_type_formatter
+{
+	constexpr auto format(const common_good::static_media_type<Literal>&, auto&& context) const
+	{
+		constexpr auto view = common_good::static_media_type<Literal>::view();
+		return write({view.string(), view.type(), view.tree(), view.subtype(), view.suffix(), view.parameters_string(), false}, context);
+	}
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if defined(COMMON_GOOD_STATS) and (defined(__x86_64__) or defined(__i386__))
+	#include <x86intrin.h>
+#endif
+
+#if defined(COMMON_GOOD_STATS)
+	#define COMMON_GOOD_STATS_BUILD enabled_build
+#else
+	#define COMMON_GOOD_STATS_BUILD disabled_build
+#endif
+
+/// @brief Parse instrumentation, enabled by defining COMMON_GOOD_STATS. Otherwise every hook compiles to nothing and `capture()`
+/// returns zeros.
+/// @brief The macro must be defined in every translation unit of a program or in none, as the CMake option COMMON_GOOD_STATS does,
+/// since the inline parse functions calling `measure` differ with it. Each build lives in an inline namespace of its own, so its
+/// counters, hooks and snapshots are distinct entities from those of the other rather than merged by the linker.
+namespace common_good::stats::inline COMMON_GOOD_STATS_BUILD
+{
+#if defined(COMMON_GOOD_STATS)
+	inline constexpr bool enabled {true};
+#else
+	inline constexpr bool enabled {false};
+#endif
+
+	/// @brief Failure counters, indexed by the underlying value of `media_type::error`.
+	inline constexpr std::size_t failure_kinds {32};
+
+	/// @brief Latency buckets, bucket `n` counting parses taking [2^(n-1), 2^n) cycles and bucket zero those taking none.
+	inline constexpr std::size_t latency_buckets {64};
+
+	/// @brief Totals over every thread at the time of `capture()`.
+	struct snapshot
+	{
+		std::uint64_t successes {};
+		std::array<std::uint64_t, failure_kinds> failures {};
+		std::array<std::uint64_t, latency_buckets> latency {};
+
+		/// @brief Get number of parses failing with error.
+		/// @param code Error, such as a `media_type::error`.
+		[[nodiscard]] constexpr auto failed(const auto code) const noexcept -> std::uint64_t
+		{ return failures[static_cast<std::size_t>(code)]; }
+
+		/// @brief Get number of parses, successful or not.
+		[[nodiscard]] constexpr auto parses() const noexcept -> std::uint64_t
+		{
+			auto total = successes;
+
+			for (const auto count : failures)
+			{
+				total += count;
+			}
+
+			return total;
+		}
+	};
+
+	/// @brief Counters of a single thread, aligned to a cache line of their own so threads never share one.
+	/// @brief Blocks are linked into a list that only grows, and a block is reused by the next thread once its thread exits, so
+	/// there are never more blocks than threads alive at once and their counts are never lost.
+	/// @brief 64 rather than `std::hardware_destructive_interference_size`, which varies with compiler flags and so between
+	/// translation units.
+	class alignas(64) counters
+	{
+		std::atomic<bool> in_use {true};
+
+		/// @brief Immutable once published.
+		counters* next {};
+
+		std::atomic<std::uint64_t> successes {};
+		std::array<std::atomic<std::uint64_t>, failure_kinds> failures {};
+		std::array<std::atomic<std::uint64_t>, latency_buckets> latency {};
+
+		inline static std::atomic<counters*> head {};
+
+		/// @brief Only the owning thread writes, so a relaxed load and store is enough and no read-modify-write is needed.
+		static void increment(std::atomic<std::uint64_t>& counter) noexcept
+		{ counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+		[[nodiscard]] static auto acquire() noexcept -> counters*
+		{
+			for (auto block = head.load(std::memory_order_acquire); block; block = block->next)
+			{
+				if (auto expected = false; block->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				{
+					return block;
+				}
+			}
+
+			/* Instrumentation must never make a parse throw, so a thread without memory is simply not counted. */
+			const auto block = new (std::nothrow) counters {};
+
+			if (block)
+			{
+				block->next = head.load(std::memory_order_relaxed);
+
+				while (not head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+				{ }
+			}
+
+			return block;
+		}
+
+		/// @brief Owner of the block of this thread, releasing it for reuse on thread exit.
+		struct owner
+		{
+			counters* block {acquire()};
+
+			~owner()
+			{
+				if (block)
+				{
+					block->in_use.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+	  public:
+		/// @brief Get timestamp in cycles, or in steady clock ticks where there is no cycle counter.
+		[[nodiscard]] static auto cycles() noexcept -> std::uint64_t
+		{
+#if defined(COMMON_GOOD_STATS) and (defined(__x86_64__) or defined(__i386__))
+			return __rdtsc();
+#else
+			return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		/// @brief Count parse outcome of calling thread.
+		/// @param failure Underlying value of the error, or nothing if successful.
+		/// @param elapsed Cycles taken.
+		static void record(const std::optional<std::size_t> failure, const std::uint64_t elapsed) noexcept
+		{
+			thread_local const owner local {};
+
+			if (not local.block)
+			{
+				return;
+			}
+
+			if (failure)
+			{
+				increment(local.block->failures[*failure]);
+			}
+			else
+			{
+				increment(local.block->successes);
+			}
+
+			increment(local.block->latency[std::min<std::size_t>(std::bit_width(elapsed), latency_buckets - 1)]);
+		}
+
+		/// @brief Sum counters of every thread, without locking. Parses in progress may or may not be included.
+		[[nodiscard]] static auto sum() noexcept -> snapshot
+		{
+			snapshot result {};
+
+			for (auto block = head.load(std::memory_order_acquire); block; block = block->next)
+			{
+				result.successes += block->successes.load(std::memory_order_relaxed);
+
+				for (std::size_t index {}; index < failure_kinds; ++index)
+				{
+					result.failures[index] += block->failures[index].load(std::memory_order_relaxed);
+				}
+
+				for (std::size_t index {}; index < latency_buckets; ++index)
+				{
+					result.latency[index] += block->latency[index].load(std::memory_order_relaxed);
+				}
+			}
+
+			return result;
+		}
+	};
+
+	/// @brief Call parse, counting its outcome and latency when enabled. Not counted during constant evaluation.
+	/// @param parse Callable returning `std::expected` with an enumeration as error.
+	/// @return Result of parse.
+	template<typename Function>
+	[[nodiscard]] constexpr auto measure(Function&& parse) -> std::invoke_result_t<Function>
+	{
+		if constexpr (enabled)
+		{
+			if !consteval
+			{
+				const auto start = counters::cycles();
+				auto result = std::forward<Function>(parse)();
+				const auto elapsed = counters::cycles() - start;
+
+				counters::record(result ? std::nullopt : std::optional {static_cast<std::size_t>(result.error())}, elapsed);
+				return result;
+			}
+		}
+
+		return std::forward<Function>(parse)();
+	}
+
+	/// @brief Get totals over every thread, without locking.
+	/// @return Totals, all zero when not enabled.
+	[[nodiscard]] inline auto capture() noexcept -> snapshot
+	{
+		if constexpr (enabled)
+		{
+			return counters::sum();
+		}
+		else
+		{
+			return {};
+		}
+	}
+}
+
+#undef COMMON_GOOD_STATS_BUILD
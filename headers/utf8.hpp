@@ -0,0 +1,283 @@
+#pragma once
+
+#include "ascii.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+namespace common_good::utf8
+{
+	/// @brief Get length of the UTF-8 sequence at offset, checked byte by byte.
+	/// @param string Characters to test.
+	/// @param index Offset of the first byte of the sequence.
+	/// @return Length in [1..4], or zero if the sequence is malformed, overlong, a surrogate, above U+10FFFF or truncated.
+	[[nodiscard]] constexpr auto sequence_size(const std::string_view string, const std::size_t index) noexcept -> std::size_t
+	{
+		const auto byte = [&](const std::size_t offset) noexcept -> unsigned
+		{ return index + offset < string.size() ? static_cast<unsigned char>(string[index + offset]) : 0; };
+
+		const auto lead = byte(0);
+
+		/* Allowed range of the byte after the lead, per RFC 3629 section 4, and number of continuation bytes. */
+		unsigned low {0x80};
+		unsigned high {0xBF};
+		std::size_t size {};
+
+		if (lead < 0x80)
+		{
+			return 1;
+		}
+		else if (lead >= 0xC2 and lead <= 0xDF)
+		{
+			size = 2;
+		}
+		else if (lead >= 0xE0 and lead <= 0xEF)
+		{
+			low = lead == 0xE0 ? 0xA0 : low;
+			high = lead == 0xED ? 0x9F : high;
+			size = 3;
+		}
+		else if (lead >= 0xF0 and lead <= 0xF4)
+		{
+			low = lead == 0xF0 ? 0x90 : low;
+			high = lead == 0xF4 ? 0x8F : high;
+			size = 4;
+		}
+		else
+		{
+			return 0;
+		}
+
+		if (byte(1) < low or byte(1) > high)
+		{
+			return 0;
+		}
+
+		for (std::size_t offset {2}; offset < size; ++offset)
+		{
+			if (byte(offset) < 0x80 or byte(offset) > 0xBF)
+			{
+				return 0;
+			}
+		}
+
+		return size;
+	}
+
+	/// @brief Test if string is valid UTF-8 as defined by RFC 3629. Vectorised where supported.
+	/// @brief Blocks of ascii are skipped with a single test each. Blocks with high bytes are validated a block at a time by table
+	/// lookups with AVX2 or NEON, after Keiser and Lemire, 'Validating UTF-8 In Less Than One Instruction Per Byte', or
+	/// sequence by sequence otherwise.
+	/// @param string Characters to test.
+	/// @return True if string is valid UTF-8, also when string is empty.
+	[[nodiscard]] constexpr auto is_valid(const std::string_view string) noexcept -> bool
+	{
+		std::size_t index {};
+
+		if !consteval
+		{
+#if defined(__AVX2__) or (defined(__ARM_NEON) and defined(__aarch64__))
+			/* Bit per fault of a pair of bytes, named after the first byte then the second. */
+			constexpr std::uint8_t too_short {1 << 0};
+			constexpr std::uint8_t too_long {1 << 1};
+			constexpr std::uint8_t overlong_3 {1 << 2};
+			constexpr std::uint8_t too_large {1 << 3};
+			constexpr std::uint8_t surrogate {1 << 4};
+			constexpr std::uint8_t overlong_2 {1 << 5};
+			constexpr std::uint8_t too_large_1000 {1 << 6};
+			constexpr std::uint8_t overlong_4 {1 << 6};
+			constexpr std::uint8_t two_continuations {1 << 7};
+			constexpr std::uint8_t carry {too_short | too_long | two_continuations};
+
+			/* Faults possible by the high nibble of the first byte. */
+			constexpr std::array<std::uint8_t, 16> first_high {too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+															   two_continuations, two_continuations, two_continuations, two_continuations,
+															   too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+															   too_short | too_large | too_large_1000 | overlong_4};
+
+			/* Faults possible by the low nibble of the first byte. */
+			constexpr std::array<std::uint8_t, 16> first_low {carry | overlong_3 | overlong_2 | overlong_4,
+															  carry | overlong_2,
+															  carry,
+															  carry,
+															  carry | too_large,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000 | surrogate,
+															  carry | too_large | too_large_1000,
+															  carry | too_large | too_large_1000};
+
+			/* Faults possible by the high nibble of the second byte. */
+			constexpr std::array<std::uint8_t, 16> second_high {
+				too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+				too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4,
+				too_long | overlong_2 | two_continuations | overlong_3 | too_large,
+				too_long | overlong_2 | two_continuations | surrogate | too_large,
+				too_long | overlong_2 | two_continuations | surrogate | too_large,
+				too_short, too_short, too_short, too_short};
+#endif
+#if defined(__AVX2__)
+			const auto table = [](const std::array<std::uint8_t, 16>& values) noexcept
+			{ return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()))); };
+
+			const auto first_high_256 = table(first_high);
+			const auto first_low_256 = table(first_low);
+			const auto second_high_256 = table(second_high);
+			const auto nibble = _mm256_set1_epi8(0x0F);
+
+			/* Last bytes of a block which, if leading a sequence, need bytes of the next block. */
+			const auto maximum = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+												  -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1),
+												  static_cast<char>(0xC0 - 1));
+
+			auto error = _mm256_setzero_si256();
+			auto previous = _mm256_setzero_si256();
+			auto incomplete = _mm256_setzero_si256();
+
+			const auto check = [&](const __m256i input) noexcept
+			{
+				if (_mm256_movemask_epi8(input) == 0)
+				{
+					error = _mm256_or_si256(error, incomplete);
+					incomplete = _mm256_setzero_si256();
+					previous = input;
+					return;
+				}
+
+				const auto straddle = _mm256_permute2x128_si256(previous, input, 0x21);
+				const auto previous_1 = _mm256_alignr_epi8(input, straddle, 15);
+				const auto previous_2 = _mm256_alignr_epi8(input, straddle, 14);
+				const auto previous_3 = _mm256_alignr_epi8(input, straddle, 13);
+
+				const auto special = _mm256_and_si256(
+					_mm256_and_si256(_mm256_shuffle_epi8(first_high_256, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble)),
+									 _mm256_shuffle_epi8(first_low_256, _mm256_and_si256(previous_1, nibble))),
+					_mm256_shuffle_epi8(second_high_256, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+				const auto third = _mm256_subs_epu8(previous_2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				const auto fourth = _mm256_subs_epu8(previous_3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+
+				/* Two continuations are valid only as the third or fourth byte of a sequence, where the bits cancel. */
+				const auto continuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+				error = _mm256_or_si256(error, _mm256_xor_si256(continuation, special));
+				incomplete = _mm256_subs_epu8(input, maximum);
+				previous = input;
+			};
+
+			for (; index + 32 <= string.size(); index += 32)
+			{
+				check(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(string.data() + index)));
+			}
+
+			/* Padding with ascii reports a sequence truncated by the end of string as too short. */
+			std::array<char, 32> last {};
+
+			if (index < string.size())
+			{
+				std::memcpy(last.data(), string.data() + index, string.size() - index);
+			}
+
+			check(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(last.data())));
+
+			return _mm256_testz_si256(_mm256_or_si256(error, incomplete), _mm256_or_si256(error, incomplete)) != 0;
+#elif defined(__ARM_NEON) and defined(__aarch64__)
+			const auto first_high_128 = vld1q_u8(first_high.data());
+			const auto first_low_128 = vld1q_u8(first_low.data());
+			const auto second_high_128 = vld1q_u8(second_high.data());
+			const auto nibble = vdupq_n_u8(0x0F);
+
+			/* Last bytes of a block which, if leading a sequence, need bytes of the next block. */
+			constexpr std::array<std::uint8_t, 16> maximum_values {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+																   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+			const auto maximum = vld1q_u8(maximum_values.data());
+
+			auto error = vdupq_n_u8(0);
+			auto previous = vdupq_n_u8(0);
+			auto incomplete = vdupq_n_u8(0);
+
+			const auto check = [&](const uint8x16_t input) noexcept
+			{
+				if (vmaxvq_u8(input) < 0x80)
+				{
+					error = vorrq_u8(error, incomplete);
+					incomplete = vdupq_n_u8(0);
+					previous = input;
+					return;
+				}
+
+				const auto previous_1 = vextq_u8(previous, input, 15);
+				const auto previous_2 = vextq_u8(previous, input, 14);
+				const auto previous_3 = vextq_u8(previous, input, 13);
+
+				const auto special = vandq_u8(vandq_u8(vqtbl1q_u8(first_high_128, vshrq_n_u8(previous_1, 4)),
+													   vqtbl1q_u8(first_low_128, vandq_u8(previous_1, nibble))),
+											  vqtbl1q_u8(second_high_128, vshrq_n_u8(input, 4)));
+
+				const auto third = vqsubq_u8(previous_2, vdupq_n_u8(0xE0 - 0x80));
+				const auto fourth = vqsubq_u8(previous_3, vdupq_n_u8(0xF0 - 0x80));
+
+				/* Two continuations are valid only as the third or fourth byte of a sequence, where the bits cancel. */
+				const auto continuation = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+				error = vorrq_u8(error, veorq_u8(continuation, special));
+				incomplete = vqsubq_u8(input, maximum);
+				previous = input;
+			};
+
+			for (; index + 16 <= string.size(); index += 16)
+			{
+				check(vld1q_u8(reinterpret_cast<const std::uint8_t*>(string.data() + index)));
+			}
+
+			/* Padding with ascii reports a sequence truncated by the end of string as too short. */
+			std::array<std::uint8_t, 16> last {};
+
+			if (index < string.size())
+			{
+				std::memcpy(last.data(), string.data() + index, string.size() - index);
+			}
+
+			check(vld1q_u8(last.data()));
+
+			return vmaxvq_u8(vorrq_u8(error, incomplete)) == 0;
+#endif
+		}
+
+		while (index < string.size())
+		{
+			/* Ascii is by far the most common, so skip a block of it with a single vectorised test where possible. */
+			if (index + 16 <= string.size() and ascii::all_ascii(string.substr(index, 16)))
+			{
+				index += 16;
+				continue;
+			}
+
+			if (const auto size = sequence_size(string, index); size != 0)
+			{
+				index += size;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,94 @@
+#include "headers/accept_list.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <format>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace common_good;
+
+TEST(accept_list, sorts_by_weight_then_specificity)
+{
+	const accept_list list {"*/*;q=0.8, text/*, text/html;q=0.9, text/plain;format=flowed, application/json"};
+
+	ASSERT_EQ(list.size(), 5u);
+	EXPECT_EQ(list[0].subtype(), "plain");
+	EXPECT_EQ(list[0].parameters_string(), "format=flowed");
+	EXPECT_EQ(list[1].subtype(), "json");
+	EXPECT_EQ(list[2].subtype(), "*");
+	EXPECT_EQ(list[3].subtype(), "html");
+	EXPECT_EQ(list[4].type(), "*");
+}
+
+TEST(accept_list, weight_of_most_specific_range)
+{
+	const accept_list list {"text/*;q=0.3, text/html;q=0.7, text/html;level=1, text/html;level=2;q=0.4, */*;q=0.5"};
+
+	EXPECT_EQ(list.weight(media_type_view {"text/html;level=1"}), 1000);
+	EXPECT_EQ(list.weight(media_type_view {"text/html"}), 700);
+	EXPECT_EQ(list.weight(media_type_view {"text/plain"}), 300);
+	EXPECT_EQ(list.weight(media_type_view {"image/jpeg"}), 500);
+	EXPECT_EQ(list.weight(media_type_view {"text/html;level=2"}), 400);
+	EXPECT_EQ(list.weight(media_type_view {"text/html;level=3"}), 700);
+}
+
+TEST(accept_list, negotiate)
+{
+	const std::vector<media_type> supported {"application/json", "text/html"};
+
+	EXPECT_EQ(negotiate(accept_list {"text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"}, supported)->string(), "text/html");
+	EXPECT_EQ(negotiate(accept_list {"application/json"}, supported)->string(), "application/json");
+	EXPECT_EQ(negotiate(accept_list {}, supported)->string(), "application/json");
+	EXPECT_FALSE(negotiate(accept_list {"image/png"}, supported));
+}
+
+TEST(accept_list, empty_elements)
+{
+	EXPECT_TRUE(accept_list {""}.empty());
+	EXPECT_TRUE(accept_list {" , ,"}.empty());
+	EXPECT_EQ(accept_list::try_parse("a/b;x=\"1,2\", c/d")->size(), 2u);
+}
+
+TEST(accept_list, rejects_malformed)
+{
+	for (const auto header : {"a/b;q=2", "a/b;q=0.1234", "a/b;q=\"1\"", "*/html", "a", "a/b;x", "te@t/*", "a/b;q=1.001"})
+	{
+		EXPECT_FALSE(accept_list::try_parse(header)) << header;
+	}
+}
+
+/* A client chooses how many ranges it sends, so a long header must still sort stably and in reasonable time. */
+TEST(accept_list, many_ranges_stay_stable)
+{
+	std::string header {};
+
+	for (int index {}; index < 5000; ++index)
+	{
+		header += std::format("type{}/sub;q=0.{}, ", index, index % 10);
+	}
+
+	const auto list = accept_list::try_parse(header);
+	ASSERT_TRUE(list);
+	ASSERT_EQ(list->size(), 5000u);
+
+	for (std::size_t index {1}; index < list->size(); ++index)
+	{
+		const auto& previous = (*list)[index - 1];
+		const auto& current = (*list)[index];
+
+		ASSERT_GE(previous.weight(), current.weight());
+
+		if (previous.weight() == current.weight())
+		{
+			ASSERT_LT(std::stoi(std::string {previous.type().substr(4)}), std::stoi(std::string {current.type().substr(4)}));
+		}
+	}
+}
+
+TEST(accept_list, constant_evaluation)
+{
+	static_assert(accept_list {"text/*;q=0.5, text/plain"}.weight(media_type_view {"TEXT/Plain"}) == 1000);
+	static_assert(accept_list {"text/*;q=0.5, text/plain"}[0].subtype() == "plain");
+}
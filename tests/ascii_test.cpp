@@ -0,0 +1,228 @@
+#include "headers/ascii.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <compare>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <utility>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Every byte value, as the C library classifies them in the "C" locale.
+	template<typename Predicate, typename Reference>
+	void expect_same_as_c_library(Predicate predicate, Reference reference)
+	{
+		for (int value {}; value < 256; ++value)
+		{
+			const auto character = static_cast<char>(value);
+			EXPECT_EQ(predicate(character), value < 128 and reference(value) != 0) << "byte " << value;
+		}
+	}
+
+	/// @brief Index of first character differing other than in ascii case, or the shorter size, one character at a time.
+	auto scalar_mismatch(const std::string_view left, const std::string_view right) -> std::size_t
+	{
+		const auto size = std::min(left.size(), right.size());
+		std::size_t index {};
+
+		while (index < size and ascii::to_lowercase(left[index]) == ascii::to_lowercase(right[index]))
+		{
+			++index;
+		}
+
+		return index;
+	}
+
+	/// @brief Lexicographic order of unsigned lowercase characters, one character at a time.
+	auto scalar_compare(const std::string_view left, const std::string_view right) -> std::weak_ordering
+	{
+		if (const auto index = scalar_mismatch(left, right); index < left.size() and index < right.size())
+		{
+			return static_cast<unsigned char>(ascii::to_lowercase(left[index])) <=> static_cast<unsigned char>(ascii::to_lowercase(right[index]));
+		}
+
+		return left.size() <=> right.size();
+	}
+
+	/// @brief Ignore-case kernels agree with the scalar definitions, in both argument orders.
+	void expect_same_as_scalar(const std::string_view left, const std::string_view right)
+	{
+		EXPECT_EQ(ascii::mismatch_ignore_case(left, right), scalar_mismatch(left, right)) << left << " " << right;
+		EXPECT_EQ(ascii::mismatch_ignore_case(right, left), scalar_mismatch(right, left)) << left << " " << right;
+		EXPECT_EQ(ascii::equals_ignore_case(left, right), left.size() == right.size() and scalar_mismatch(left, right) == left.size())
+			<< left << " " << right;
+		EXPECT_EQ(ascii::compare_ignore_case(left, right), scalar_compare(left, right)) << left << " " << right;
+		EXPECT_EQ(ascii::compare_ignore_case(right, left), scalar_compare(right, left)) << left << " " << right;
+	}
+}
+
+TEST(ascii, predicates_match_c_library)
+{
+	expect_same_as_c_library(ascii::is_digit, [](const int c) { return std::isdigit(c); });
+	expect_same_as_c_library(ascii::is_alphabetic_lowercase, [](const int c) { return std::islower(c); });
+	expect_same_as_c_library(ascii::is_alphabetic_uppercase, [](const int c) { return std::isupper(c); });
+	expect_same_as_c_library(ascii::is_alphabetic, [](const int c) { return std::isalpha(c); });
+	expect_same_as_c_library(ascii::is_alphanumeric, [](const int c) { return std::isalnum(c); });
+	expect_same_as_c_library(ascii::is_alphanumeric_lowercase, [](const int c) { return std::islower(c) or std::isdigit(c); });
+	expect_same_as_c_library(ascii::is_alphanumeric_uppercase, [](const int c) { return std::isupper(c) or std::isdigit(c); });
+	expect_same_as_c_library(ascii::is_hexadecimal, [](const int c) { return std::isxdigit(c); });
+	expect_same_as_c_library(ascii::is_space, [](const int c) { return std::isspace(c); });
+	expect_same_as_c_library(ascii::is_blank, [](const int c) { return std::isblank(c); });
+	expect_same_as_c_library(ascii::is_punctuation, [](const int c) { return std::ispunct(c); });
+	expect_same_as_c_library(ascii::is_control, [](const int c) { return std::iscntrl(c); });
+	expect_same_as_c_library(ascii::is_printable, [](const int c) { return std::isprint(c); });
+	expect_same_as_c_library(ascii::is_graphical, [](const int c) { return std::isgraph(c); });
+	expect_same_as_c_library(ascii::is_whitespace, [](const int c) { return std::isspace(c) and c != '\v'; });
+	expect_same_as_c_library(ascii::is_ascii, [](const int) { return true; });
+}
+
+TEST(ascii, conversions_match_c_library)
+{
+	for (int value {}; value < 256; ++value)
+	{
+		const auto character = static_cast<char>(value);
+		const auto expected_lowercase = value < 128 ? static_cast<char>(std::tolower(value)) : character;
+		const auto expected_uppercase = value < 128 ? static_cast<char>(std::toupper(value)) : character;
+
+		EXPECT_EQ(ascii::to_lowercase(character), expected_lowercase) << "byte " << value;
+		EXPECT_EQ(ascii::to_uppercase(character), expected_uppercase) << "byte " << value;
+	}
+}
+
+TEST(ascii, grammar_classes)
+{
+	constexpr std::string_view restricted_punctuation {"!#$&-^_"};
+	constexpr std::string_view token_punctuation {"!#$%&'*+-.^_`|~"};
+
+	for (int value {}; value < 256; ++value)
+	{
+		const auto character = static_cast<char>(value);
+		const auto alphanumeric = ascii::is_alphanumeric(character);
+		const auto modified = alphanumeric or restricted_punctuation.contains(character);
+
+		EXPECT_EQ(ascii::matches(character, ascii::character_class::modified_restricted_name), modified) << "byte " << value;
+		EXPECT_EQ(ascii::matches(character, ascii::character_class::restricted_name), modified or character == '.' or character == '+')
+			<< "byte " << value;
+		EXPECT_EQ(ascii::matches(character, ascii::character_class::token), alphanumeric or token_punctuation.contains(character))
+			<< "byte " << value;
+	}
+}
+
+TEST(ascii, combined_masks)
+{
+	constexpr auto mask = ascii::character_class::digit | ascii::character_class::blank;
+
+	EXPECT_TRUE(ascii::matches('7', mask));
+	EXPECT_TRUE(ascii::matches('\t', mask));
+	EXPECT_FALSE(ascii::matches('a', mask));
+	EXPECT_FALSE(ascii::matches('\xE9', mask));
+}
+
+TEST(ascii, constant_evaluation)
+{
+	static_assert(ascii::is_digit('0') and not ascii::is_digit('/'));
+	static_assert(ascii::to_lowercase('Q') == 'q' and ascii::to_uppercase('q') == 'Q');
+	static_assert(ascii::matches('+', ascii::character_class::token));
+}
+
+TEST(ascii, bulk_kernels_match_per_character)
+{
+	/* Lengths around the 16 and 32 byte blocks, with the odd byte at every position to reach each lane and the scalar tail. */
+	for (std::size_t length {}; length < 80; ++length)
+	{
+		for (std::size_t position {}; position <= length; ++position)
+		{
+			for (const auto odd : {'\x7F', '\x80', '\xFF', '\x1F', 'A', 'z'})
+			{
+				std::string string(length, 'm');
+
+				if (position < length)
+				{
+					string[position] = odd;
+				}
+
+				EXPECT_EQ(ascii::all_ascii(string), std::ranges::all_of(string, ascii::is_ascii)) << length << ' ' << position;
+				EXPECT_EQ(ascii::all_printable(string), std::ranges::all_of(string, ascii::is_printable)) << length << ' ' << position;
+
+				auto lowercase = string;
+				auto uppercase = string;
+				ascii::to_lowercase_in_place(lowercase);
+				ascii::to_uppercase_in_place(uppercase);
+
+				for (std::size_t index {}; index < length; ++index)
+				{
+					EXPECT_EQ(lowercase[index], ascii::to_lowercase(string[index])) << length << ' ' << index;
+					EXPECT_EQ(uppercase[index], ascii::to_uppercase(string[index])) << length << ' ' << index;
+				}
+			}
+		}
+	}
+}
+
+TEST(ascii, ignore_case_kernels_match_per_character)
+{
+	/* Pairs differing in case only, in bit 0x20 without being letters, outside ascii, or in another bit. */
+	constexpr std::pair<char, char> pairs[] {{'a', 'A'}, {'z', 'Z'}, {'@', '`'}, {'[', '{'}, {']', '}'}, {'^', '~'}, {'\x80', '\xA0'},
+											 {'\xC1', '\xE1'}, {'a', 'b'}, {'m', '-'}, {'\x7F', '\xFF'}};
+
+	constexpr std::string_view pattern {"aZ9-@[mQ`{x/"};
+
+	for (std::size_t length {}; length <= 80; ++length)
+	{
+		/* Equal ignoring case, with different case wherever the pattern has a letter. */
+		std::string left(length, ' ');
+		std::string right(length, ' ');
+
+		for (std::size_t index {}; index < length; ++index)
+		{
+			left[index] = pattern[index % pattern.size()];
+			right[index] = ascii::is_alphabetic(left[index]) ? static_cast<char>(left[index] ^ 0x20) : left[index];
+		}
+
+		expect_same_as_scalar(left, right);
+		EXPECT_TRUE(ascii::equals_ignore_case(left, right)) << length;
+
+		if (length > 0)
+		{
+			expect_same_as_scalar(left, std::string_view {right}.substr(0, length - 1));
+		}
+
+		for (std::size_t position {}; position < length; ++position)
+		{
+			for (const auto& [first, second] : pairs)
+			{
+				auto changed_left = left;
+				auto changed_right = right;
+				changed_left[position] = first;
+				changed_right[position] = second;
+
+				expect_same_as_scalar(changed_left, changed_right);
+			}
+		}
+	}
+}
+
+TEST(ascii, find_first_not)
+{
+	EXPECT_EQ(ascii::find_first_not("text/html", ascii::character_class::alphabetic), 4u);
+	EXPECT_EQ(ascii::find_first_not("html", ascii::character_class::alphabetic), std::string_view::npos);
+	EXPECT_TRUE(ascii::all_of("", ascii::character_class::digit));
+	EXPECT_FALSE(ascii::all_of("12a", ascii::character_class::digit));
+}
+
+TEST(ascii, bulk_constant_evaluation)
+{
+	static_assert(ascii::all_ascii("text/html") and not ascii::all_ascii("caf\xC3\xA9"));
+	static_assert(ascii::all_printable("text/html") and not ascii::all_printable("text\n"));
+	static_assert([]
+	{
+		char string[] {"Text/HTML"};
+		ascii::to_lowercase_in_place(string);
+		return std::string_view {string} == "text/html";
+	}());
+}
@@ -0,0 +1,17 @@
+#include "common_good"
+
+#include <gtest/gtest.h>
+
+using namespace common_good;
+
+/* Every header through the umbrella, so a header no other test includes still has to compile. */
+TEST(common_good, umbrella_header)
+{
+	const media_type type {"Application/Vnd.API+JSON; Charset=UTF-8"};
+	const media_type_view view {type};
+	const compact_media_type compact {type};
+
+	EXPECT_EQ(view, type);
+	EXPECT_EQ(compact, type);
+	EXPECT_EQ(media_type {view}, type);
+}
@@ -0,0 +1,99 @@
+#include "headers/fixed_media_type.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Initialised at compile time, so safe to use from other static initialisers.
+	constinit const fixed_media_type<> routes[] {"text/html", "Application/Vnd.Api+JSON; Charset=UTF-8", "image/svg+xml;A=\"b c\" ;d=e"};
+
+	constexpr fixed_media_type<44> json {"Application/LD+JSON ; Profile=\"x\"; charset=utf-8"};
+
+	static_assert(json.string() == "application/ld+json");
+	static_assert(json.type() == "application");
+	static_assert(json.tree() == "");
+	static_assert(json.subtype() == "ld");
+	static_assert(json.suffix() == "+json");
+	static_assert(json.structured_suffix() == structured_suffix::json);
+	static_assert(json.top_level_type() == top_level_type::application);
+	static_assert(json.in_standards_tree());
+	static_assert(json.parameters_string() == "profile=\"x\";charset=utf-8");
+	static_assert(json.parameter("PROFILE") == "x");
+	static_assert(json.parameter("q") == std::nullopt);
+	static_assert(json == "application/LD+json");
+	static_assert(json == fixed_media_type<64> {"application/ld+json"});
+	static_assert(json.hash() == media_type::hash_ignore_case("application/ld+json"));
+}
+
+TEST(fixed_media_type, constinit_table)
+{
+	EXPECT_EQ(routes[0].string(), "text/html");
+	EXPECT_EQ(routes[0].parameters_string(), "");
+	EXPECT_EQ(routes[1].string(), "application/vnd.api+json");
+	EXPECT_EQ(routes[1].tree(), "vnd.");
+	EXPECT_EQ(routes[1].parameters_string(), "charset=UTF-8");
+	EXPECT_EQ(routes[2].parameters_string(), "a=\"b c\";d=e");
+	EXPECT_EQ(routes[2].parameter("a"), "b c");
+}
+
+TEST(fixed_media_type, compares_with_runtime_media_type)
+{
+	for (const auto& fixed : routes)
+	{
+		const media_type type {std::string {fixed.string()} + ";q=1"};
+		const media_type other {"text/plain"};
+
+		EXPECT_EQ(fixed, type) << fixed.string();
+		EXPECT_EQ(fixed, media_type_view {type}) << fixed.string();
+		EXPECT_EQ(fixed <=> type, std::weak_ordering::equivalent) << fixed.string();
+		EXPECT_EQ(fixed <=> other, media_type {fixed.string()} <=> other) << fixed.string();
+		EXPECT_NE(fixed, other) << fixed.string();
+		EXPECT_EQ(std::hash<fixed_media_type<>> {}(fixed), std::hash<media_type> {}(type)) << fixed.string();
+	}
+}
+
+TEST(fixed_media_type, converts_keeping_components)
+{
+	for (const auto& fixed : routes)
+	{
+		/* Converted from the stored offsets, so every component agrees with parsing the same text. */
+		const auto converted = static_cast<media_type>(fixed);
+		const media_type parsed {std::string {fixed.string()} + (fixed.parameters_string().empty() ? "" : ";")
+								 + std::string {fixed.parameters_string()}};
+
+		EXPECT_EQ(converted.string(), parsed.string());
+		EXPECT_EQ(converted.type(), parsed.type());
+		EXPECT_EQ(converted.tree(), parsed.tree());
+		EXPECT_EQ(converted.subtype(), parsed.subtype());
+		EXPECT_EQ(converted.suffix(), parsed.suffix());
+		EXPECT_TRUE(std::ranges::equal(converted.parameters(), parsed.parameters()));
+		EXPECT_EQ(converted.hash(), fixed.hash());
+
+		const fixed_media_type<> back {converted};
+		EXPECT_EQ(back, fixed);
+		EXPECT_EQ(back.parameters_string(), fixed.parameters_string());
+	}
+}
+
+TEST(fixed_media_type, throws_beyond_capacity)
+{
+	/* Capacity counts the type and the canonical parameters, without whitespace or the leading ';'. */
+	EXPECT_NO_THROW(fixed_media_type<9> {"text/html"});
+	EXPECT_THROW(fixed_media_type<8> {"text/html"}, std::length_error);
+	EXPECT_NO_THROW(fixed_media_type<12> {"text/html ; A=b"});
+	EXPECT_THROW(fixed_media_type<11> {"text/html ; A=b"}, std::length_error);
+	EXPECT_NO_THROW(fixed_media_type<18> {"text/html;a=b; c=\"d\""});
+	EXPECT_THROW(fixed_media_type<17> {"text/html;a=b; c=\"d\""}, std::length_error);
+	EXPECT_THROW(fixed_media_type<8> {media_type {"text/html"}}, std::length_error);
+
+	EXPECT_THROW(fixed_media_type<> {"text"}, media_type::parsing_error);
+}
@@ -0,0 +1,172 @@
+#include "headers/flat_media_type_map.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Media types of the entries in map order.
+	auto keys(const flat_media_type_map<int>& map) -> std::vector<std::string>
+	{
+		std::vector<std::string> result {};
+
+		for (const auto& [type, value] : map)
+		{
+			result.push_back(type.string());
+		}
+
+		return result;
+	}
+
+	/// @brief Media types differing in every component, in case, and in parameters alone.
+	const std::vector<std::string> types {"text/html",
+										  "Text/HTML",
+										  "text/html;charset=utf-8",
+										  "text/plain",
+										  "text/html+xml",
+										  "text/vnd.html",
+										  "application/json",
+										  "application/problem+json",
+										  "application/vnd.api+json",
+										  "application/vnd.api.v2+json",
+										  "image/svg+xml",
+										  "image/png"};
+}
+
+TEST(flat_media_type_map, bulk_construction_sorts_and_keeps_first_duplicate)
+{
+	const flat_media_type_map<int> map {{media_type {"text/plain"}, 1},
+										{media_type {"Text/HTML"}, 2},
+										{media_type {"application/json"}, 3},
+										{media_type {"text/html; charset=utf-8"}, 4},
+										{media_type {"TEXT/PLAIN"}, 5},
+										{media_type {"text/html"}, 6}};
+
+	EXPECT_EQ(map.size(), 3);
+	EXPECT_EQ(keys(map), (std::vector<std::string> {"application/json", "text/html", "text/plain"}));
+	EXPECT_EQ(map.at("text/html"), 2);
+	EXPECT_EQ(map.at("text/plain"), 1);
+	EXPECT_TRUE(std::ranges::is_sorted(map, std::ranges::less {}, [](const auto& entry) { return entry.first; }));
+}
+
+TEST(flat_media_type_map, finds_by_string_view_and_media_type)
+{
+	flat_media_type_map<int> map {{media_type {"application/vnd.api+json"}, 1}, {media_type {"image/png"}, 2}};
+
+	const media_type type {"Application/Vnd.Api+JSON"};
+	const std::string string {"IMAGE/PNG; q=0.5"};
+	const media_type_view view {string};
+
+	EXPECT_EQ(map.find(type)->second, 1);
+	EXPECT_EQ(map.find(view)->second, 2);
+	EXPECT_EQ(map.find(std::string_view {"application/VND.api+json"})->second, 1);
+	EXPECT_EQ(map.find("image/png")->second, 2);
+	EXPECT_EQ(map.find(string)->second, 2);
+	EXPECT_EQ(std::as_const(map).find(view)->second, 2);
+
+	EXPECT_TRUE(map.contains(type));
+	EXPECT_TRUE(map.contains(view));
+	EXPECT_FALSE(map.contains("application/json"));
+
+	EXPECT_EQ(map.at(type), 1);
+	EXPECT_EQ(map.at(view), 2);
+	map.at("image/png") = 3;
+	EXPECT_EQ(std::as_const(map).at(view), 3);
+	EXPECT_THROW(static_cast<void>(map.at("image/gif")), std::out_of_range);
+}
+
+TEST(flat_media_type_map, unparseable_string_matches_nothing)
+{
+	flat_media_type_map<int> map {{media_type {"text/html"}, 1}};
+
+	for (const std::string_view key : {"text", "", "text/html;charset", "te(t/html", "text/html/"})
+	{
+		EXPECT_EQ(map.find(key), map.end()) << key;
+		EXPECT_FALSE(map.contains(key)) << key;
+		EXPECT_THROW(static_cast<void>(map.at(key)), std::out_of_range) << key;
+		EXPECT_EQ(map.erase(key), 0) << key;
+	}
+
+	EXPECT_EQ(map.size(), 1);
+}
+
+TEST(flat_media_type_map, erases_by_string_view_and_media_type)
+{
+	flat_media_type_map<int> map {{media_type {"text/html"}, 1}, {media_type {"text/plain"}, 2}, {media_type {"image/png"}, 3},
+								  {media_type {"image/gif"}, 4}};
+
+	const std::string png {"Image/PNG"};
+
+	EXPECT_EQ(map.erase(media_type {"TEXT/HTML"}), 1);
+	EXPECT_EQ(map.erase(media_type_view {png}), 1);
+	EXPECT_EQ(map.erase("text/plain;charset=utf-8"), 1);
+	EXPECT_EQ(map.erase("text/plain"), 0);
+	EXPECT_EQ(keys(map), (std::vector<std::string> {"image/gif"}));
+
+	const auto next = map.erase(map.find("image/gif"));
+	EXPECT_EQ(next, map.end());
+	EXPECT_TRUE(map.empty());
+}
+
+TEST(flat_media_type_map, insertion_keeps_order)
+{
+	flat_media_type_map<int> map {};
+
+	for (std::size_t index {}; index < types.size(); ++index)
+	{
+		const auto [position, inserted] = map.insert({media_type {types[index]}, static_cast<int>(index)});
+		EXPECT_EQ(position->first, media_type {types[index]}) << types[index];
+		EXPECT_EQ(inserted, map.at(types[index]) == static_cast<int>(index)) << types[index];
+		EXPECT_TRUE(std::ranges::is_sorted(map, std::ranges::less {}, [](const auto& entry) { return entry.first; })) << types[index];
+	}
+
+	/* Equal types ignoring case and parameters are not added again, nor replace the value. */
+	EXPECT_EQ(map.size(), types.size() - 2);
+	EXPECT_EQ(map.at("text/html"), 0);
+
+	const auto [replaced, added] = map.insert_or_assign(media_type {"TEXT/HTML"}, 100);
+	EXPECT_FALSE(added);
+	EXPECT_EQ(replaced->second, 100);
+	EXPECT_EQ(map.at("text/html"), 100);
+
+	const auto [appended, new_entry] = map.insert_or_assign(media_type {"audio/ogg"}, 101);
+	EXPECT_TRUE(new_entry);
+	EXPECT_EQ(appended->second, 101);
+	EXPECT_EQ(map.size(), types.size() - 1);
+	EXPECT_TRUE(std::ranges::is_sorted(map, std::ranges::less {}, [](const auto& entry) { return entry.first; }));
+}
+
+TEST(flat_media_type_map, ordering_agrees_with_equality)
+{
+	for (const auto& left : types)
+	{
+		for (const auto& right : types)
+		{
+			const media_type left_type {left};
+			const media_type right_type {right};
+			const media_type_view left_view {left};
+			const media_type_view right_view {right};
+
+			const auto equal = left_type == right_type;
+
+			EXPECT_EQ((left_type <=> right_type) == 0, equal) << left << " " << right;
+			EXPECT_EQ(left_view == right_view, equal) << left << " " << right;
+			EXPECT_EQ((left_view <=> right_view) == 0, equal) << left << " " << right;
+			EXPECT_EQ(left_view == right_type, equal) << left << " " << right;
+			EXPECT_EQ((left_view <=> right_type) == 0, equal) << left << " " << right;
+
+			/* Views and owning types order the same way, in both directions. */
+			EXPECT_EQ(left_view <=> right_view, left_type <=> right_type) << left << " " << right;
+			EXPECT_EQ(left_view <=> right_type, left_type <=> right_type) << left << " " << right;
+			EXPECT_EQ(right_type <=> left_type, 0 <=> (left_type <=> right_type)) << left << " " << right;
+		}
+	}
+}
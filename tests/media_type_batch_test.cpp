@@ -0,0 +1,153 @@
+#include "headers/media_type_batch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	constexpr std::array<std::string_view, 14> rows {
+		"text/html",
+		"Application/Vnd.Api+JSON; Charset=UTF-8",
+		"image/svg+xml;a=\"b;c\";d=e",
+		"application/vnd.foo.bar.baz+json+zip",
+		"multipart/form-data ; boundary=frontier",
+		"x.y/z",
+		"text",
+		"",
+		"te(t/html",
+		"text/ht ml",
+		"text/html;charset",
+		"text/html;a=\"unterminated",
+		"application/vnd.",
+		"text/plain;q=0.5",
+	};
+
+	/// @brief Storage of every column, sized independently so one may fall short.
+	struct storage
+	{
+		std::vector<std::uint8_t> status;
+		std::vector<std::uint16_t> type_size;
+		std::vector<std::uint32_t> parameters;
+		std::vector<unsigned char> after_slash;
+		std::vector<unsigned char> after_first_dot;
+		std::vector<unsigned char> last_plus;
+
+		explicit storage(const std::size_t size) :
+			status(size, 0xAA), type_size(size, 0xAA), parameters(size, 0xAA), after_slash(size, 0xAA), after_first_dot(size, 0xAA),
+			last_plus(size, 0xAA)
+		{ }
+
+		auto columns() -> media_type_columns { return {status, type_size, parameters, after_slash, after_first_dot, last_plus}; }
+	};
+
+	/// @brief Every column of every row agrees with parsing that row alone.
+	void expect_same_as_parse(const media_type_columns& columns)
+	{
+		for (std::size_t row {}; row < rows.size(); ++row)
+		{
+			const auto type = rows[row];
+			const auto parsed = media_type_view::try_parse(type);
+
+			if (not parsed)
+			{
+				EXPECT_EQ(columns.error(row), parsed.error()) << type;
+				EXPECT_EQ(columns.status[row], static_cast<std::uint8_t>(parsed.error())) << type;
+				EXPECT_EQ(columns.type_size[row], 0) << type;
+				EXPECT_EQ(columns.parameters[row], type.size()) << type;
+				EXPECT_EQ(columns.after_slash[row], 0) << type;
+				EXPECT_EQ(columns.after_first_dot[row], 0) << type;
+				EXPECT_EQ(columns.last_plus[row], 0) << type;
+				continue;
+			}
+
+			/* The offsets locate the same components as the accessors of the view. */
+			const std::size_t after_slash {columns.after_slash[row]};
+			const auto subtype = after_slash + columns.after_first_dot[row];
+
+			EXPECT_EQ(columns.error(row), std::nullopt) << type;
+			EXPECT_EQ(columns.status[row], media_type_columns::valid) << type;
+			EXPECT_EQ(type.substr(0, columns.type_size[row]), parsed->string()) << type;
+			EXPECT_EQ(type.substr(columns.parameters[row]), parsed->parameters_string()) << type;
+			EXPECT_EQ(type.substr(0, after_slash - 1), parsed->type()) << type;
+			EXPECT_EQ(type.substr(after_slash, columns.after_first_dot[row]), parsed->tree()) << type;
+
+			if (columns.last_plus[row])
+			{
+				EXPECT_EQ(type.substr(subtype, columns.last_plus[row]), parsed->subtype()) << type;
+				EXPECT_EQ(type.substr(subtype + columns.last_plus[row], columns.type_size[row] - subtype - columns.last_plus[row]),
+						  parsed->suffix())
+					<< type;
+			}
+			else
+			{
+				EXPECT_EQ(type.substr(subtype, columns.type_size[row] - subtype), parsed->subtype()) << type;
+				EXPECT_EQ(parsed->suffix(), "") << type;
+			}
+		}
+	}
+}
+
+TEST(media_type_batch, matches_try_parse_row_by_row)
+{
+	storage storage {rows.size()};
+	validate_batch(rows, storage.columns());
+	expect_same_as_parse(storage.columns());
+}
+
+TEST(media_type_batch, policy_overload_matches_try_parse_row_by_row)
+{
+	storage sequenced {rows.size()};
+	validate_batch(std::execution::seq, rows, sequenced.columns());
+	expect_same_as_parse(sequenced.columns());
+
+	storage unsequenced {rows.size()};
+	validate_batch(std::execution::unseq, rows, unsequenced.columns());
+	expect_same_as_parse(unsequenced.columns());
+}
+
+TEST(media_type_batch, longer_columns_keep_rows_past_input)
+{
+	storage storage {rows.size() + 2};
+	validate_batch(rows, storage.columns());
+
+	EXPECT_EQ(storage.status[rows.size()], 0xAA);
+	EXPECT_EQ(storage.parameters[rows.size() + 1], 0xAA);
+}
+
+TEST(media_type_batch, rejects_columns_shorter_than_input)
+{
+	/* Each column in turn one row short, as a single short column is enough to reject the batch. */
+	for (std::size_t column {}; column < 6; ++column)
+	{
+		storage storage {rows.size()};
+		auto columns = storage.columns();
+
+		switch (column)
+		{
+			case 0: columns.status = columns.status.first(rows.size() - 1); break;
+			case 1: columns.type_size = columns.type_size.first(rows.size() - 1); break;
+			case 2: columns.parameters = columns.parameters.first(rows.size() - 1); break;
+			case 3: columns.after_slash = columns.after_slash.first(rows.size() - 1); break;
+			case 4: columns.after_first_dot = columns.after_first_dot.first(rows.size() - 1); break;
+			default: columns.last_plus = columns.last_plus.first(rows.size() - 1); break;
+		}
+
+		EXPECT_THROW(validate_batch(rows, columns), std::length_error) << "column " << column;
+		EXPECT_THROW(validate_batch(std::execution::seq, rows, columns), std::length_error) << "column " << column;
+
+		/* Nothing is written before the check. */
+		EXPECT_EQ(storage.status[0], 0xAA) << "column " << column;
+	}
+
+	storage empty {0};
+	EXPECT_NO_THROW(validate_batch(std::span<const std::string_view> {}, empty.columns()));
+}
@@ -0,0 +1,186 @@
+#include "headers/media_type_cache.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Same result as parsing header directly, down to the characters each accessor views.
+	void expect_same_as_parse(const std::expected<media_type_view, media_type::error>& cached, const std::string_view header)
+	{
+		const auto parsed = media_type_view::try_parse(header);
+
+		ASSERT_EQ(cached.has_value(), parsed.has_value()) << header;
+
+		if (not parsed)
+		{
+			EXPECT_EQ(cached.error(), parsed.error()) << header;
+			return;
+		}
+
+		EXPECT_EQ(cached->string().data(), parsed->string().data()) << header;
+		EXPECT_EQ(cached->string().size(), parsed->string().size()) << header;
+		EXPECT_EQ(cached->type(), parsed->type()) << header;
+		EXPECT_EQ(cached->tree(), parsed->tree()) << header;
+		EXPECT_EQ(cached->subtype(), parsed->subtype()) << header;
+		EXPECT_EQ(cached->suffix(), parsed->suffix()) << header;
+		EXPECT_EQ(cached->parameters_string(), parsed->parameters_string()) << header;
+
+		if (not parsed->parameters_string().empty())
+		{
+			EXPECT_EQ(cached->parameters_string().data(), parsed->parameters_string().data()) << header;
+		}
+	}
+}
+
+TEST(media_type_cache, hit_returns_same_view_as_miss)
+{
+	media_type_cache cache {};
+
+	for (const std::string_view header : {"text/html", "Application/Vnd.Api+JSON; Charset=UTF-8", "image/svg+xml;a=\"b c\";d=e"})
+	{
+		EXPECT_FALSE(cache.contains(header));
+		expect_same_as_parse(cache.try_parse(header), header);
+		EXPECT_TRUE(cache.contains(header));
+
+		/* Equal bytes elsewhere hit the entry, viewing the new header rather than the first. */
+		const std::string copy {header};
+		expect_same_as_parse(cache.try_parse(copy), copy);
+	}
+}
+
+TEST(media_type_cache, caches_failure)
+{
+	media_type_cache cache {};
+
+	for (const std::string_view header : {"text", "text/html;charset", "te(t/html", ""})
+	{
+		const auto missed = cache.try_parse(header);
+		EXPECT_TRUE(cache.contains(header)) << header;
+
+		const auto hit = cache.try_parse(header);
+
+		ASSERT_FALSE(missed);
+		ASSERT_FALSE(hit);
+		EXPECT_EQ(hit.error(), missed.error()) << header;
+		EXPECT_EQ(hit.error(), media_type_view::try_parse(header).error()) << header;
+	}
+}
+
+TEST(media_type_cache, keys_by_exact_bytes)
+{
+	media_type_cache cache {};
+
+	expect_same_as_parse(cache.try_parse("text/html"), "text/html");
+
+	EXPECT_FALSE(cache.contains("Text/HTML"));
+	EXPECT_FALSE(cache.contains("text/htm"));
+	EXPECT_FALSE(cache.contains(std::string_view {"text/html\0", 10}));
+}
+
+TEST(media_type_cache, clock_evicts_unreferenced_entry_of_a_full_set)
+{
+	/* A single set, so every header competes for the same four slots. */
+	media_type_cache cache {media_type_cache::ways};
+	ASSERT_EQ(cache.capacity(), media_type_cache::ways);
+
+	for (const auto header : {"text/a", "text/b", "text/c", "text/d"})
+	{
+		static_cast<void>(cache.try_parse(header));
+	}
+
+	/* Hits mark entries referenced, so the hand passes over them once. */
+	static_cast<void>(cache.try_parse("text/a"));
+	static_cast<void>(cache.try_parse("text/c"));
+
+	static_cast<void>(cache.try_parse("text/e"));
+
+	EXPECT_TRUE(cache.contains("text/a"));
+	EXPECT_FALSE(cache.contains("text/b"));
+	EXPECT_TRUE(cache.contains("text/c"));
+	EXPECT_TRUE(cache.contains("text/d"));
+	EXPECT_TRUE(cache.contains("text/e"));
+
+	/* The hand now stands at text/c, and clears its reference bit on the way to evicting text/d. */
+	static_cast<void>(cache.try_parse("text/f"));
+
+	EXPECT_TRUE(cache.contains("text/a"));
+	EXPECT_TRUE(cache.contains("text/e"));
+	EXPECT_TRUE(cache.contains("text/f"));
+	EXPECT_FALSE(cache.contains("text/d"));
+}
+
+TEST(media_type_cache, long_header_bypasses_cache)
+{
+	media_type_cache cache {};
+
+	const auto longest = "text/" + std::string(media_type_cache::key_capacity - 5, 'a');
+	const auto longer = longest + "a";
+
+	expect_same_as_parse(cache.try_parse(longest), longest);
+	EXPECT_TRUE(cache.contains(longest));
+
+	expect_same_as_parse(cache.try_parse(longer), longer);
+	expect_same_as_parse(cache.try_parse(longer), longer);
+	EXPECT_FALSE(cache.contains(longer));
+
+	const auto long_parameters = "text/plain;a=" + std::string(200, 'b');
+	expect_same_as_parse(cache.try_parse(long_parameters), long_parameters);
+	EXPECT_FALSE(cache.contains(long_parameters));
+}
+
+TEST(media_type_cache, concurrent_readers_and_writers_agree_with_parse)
+{
+	constexpr std::size_t threads {4};
+	constexpr std::size_t rounds {20000};
+
+	/* More distinct headers than entries, so threads keep evicting the slots others are reading. */
+	media_type_cache cache {16};
+	std::vector<std::string> headers {};
+
+	for (std::size_t index {}; index < 64; ++index)
+	{
+		headers.push_back(index % 5 == 0 ? "invalid type " + std::to_string(index)
+										 : "application/vnd.x" + std::to_string(index) + "+json; q=0." + std::to_string(index % 10));
+	}
+
+	std::atomic<std::size_t> mismatches {};
+	std::vector<std::thread> workers {};
+
+	for (std::size_t thread {}; thread < threads; ++thread)
+	{
+		workers.emplace_back([&, thread]
+		{
+			for (std::size_t round {}; round < rounds; ++round)
+			{
+				const std::string_view header {headers[(round * (thread + 1) + thread) % headers.size()]};
+				const auto cached = cache.try_parse(header);
+				const auto parsed = media_type_view::try_parse(header);
+
+				const auto same = cached.has_value() == parsed.has_value()
+								  and (cached ? cached->string() == parsed->string() and cached->subtype() == parsed->subtype()
+													and cached->parameters_string() == parsed->parameters_string()
+											  : cached.error() == parsed.error());
+
+				if (not same)
+				{
+					mismatches.fetch_add(1);
+				}
+			}
+		});
+	}
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	EXPECT_EQ(mismatches.load(), 0);
+}
@@ -0,0 +1,77 @@
+#include "headers/media_type_charset.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	auto charset_named(const std::string_view type) -> charset { return charset_of(media_type_view {type}); }
+
+	constexpr std::string_view ascii_body {"plain text"};
+	constexpr std::string_view utf_8_body {"caf\xC3\xA9"};
+	constexpr std::string_view latin_1_body {"caf\xE9"};
+}
+
+TEST(media_type_charset, matches_registered_aliases_ignoring_case)
+{
+	EXPECT_EQ(charset_named("text/plain; charset=utf-8"), charset::utf_8);
+	EXPECT_EQ(charset_named("Text/HTML; Charset=UTF-8"), charset::utf_8);
+	EXPECT_EQ(charset_named("text/html; charset=\"CsUtf8\""), charset::utf_8);
+	EXPECT_EQ(charset_named("text/plain; charset=US-ASCII"), charset::us_ascii);
+	EXPECT_EQ(charset_named("text/plain; charset=\"us-ascii\""), charset::us_ascii);
+	EXPECT_EQ(charset_named("text/plain; charset=ANSI_X3.4-1968"), charset::us_ascii);
+	EXPECT_EQ(charset_named("text/plain; charset=\"iso_646.irv:1991\""), charset::us_ascii);
+	EXPECT_EQ(charset_named("text/plain; charset=cp367"), charset::us_ascii);
+	EXPECT_EQ(charset_named("text/plain; format=flowed; charset=csASCII"), charset::us_ascii);
+}
+
+TEST(media_type_charset, unknown_charset)
+{
+	EXPECT_EQ(charset_named("text/plain"), charset::unknown);
+	EXPECT_EQ(charset_named("text/plain; charset=iso-8859-1"), charset::unknown);
+	EXPECT_EQ(charset_named("text/plain; charset=utf8"), charset::unknown);
+	EXPECT_EQ(charset_named("text/plain; charset=utf-8x"), charset::unknown);
+	EXPECT_EQ(charset_named("application/json; charset=utf-8"), charset::unknown);
+	EXPECT_EQ(charset_named("textual/plain; charset=utf-8"), charset::unknown);
+}
+
+TEST(media_type_charset, validates_body_by_charset)
+{
+	EXPECT_EQ(validate_body(charset::us_ascii, ascii_body), true);
+	EXPECT_EQ(validate_body(charset::us_ascii, utf_8_body), false);
+	EXPECT_EQ(validate_body(charset::utf_8, utf_8_body), true);
+	EXPECT_EQ(validate_body(charset::utf_8, latin_1_body), false);
+	EXPECT_EQ(validate_body(charset::unknown, latin_1_body), std::nullopt);
+}
+
+TEST(media_type_charset, validates_body_by_media_type)
+{
+	EXPECT_EQ(validate_body(media_type_view {"text/plain; charset=us-ascii"}, utf_8_body), false);
+	EXPECT_EQ(validate_body(media_type_view {"text/plain; charset=UTF-8"}, utf_8_body), true);
+	EXPECT_EQ(validate_body(media_type_view {"text/plain; charset=UTF-8"}, latin_1_body), false);
+	EXPECT_EQ(validate_body(media_type_view {"text/plain; charset=iso-8859-1"}, latin_1_body), std::nullopt);
+	EXPECT_EQ(validate_body(media_type_view {"image/png"}, latin_1_body), std::nullopt);
+}
+
+TEST(media_type_charset, static_media_type_chooses_validator_at_compile_time)
+{
+	/* The charset of a literal is a constant, so the result is too. */
+	static_assert(validate_body(static_media_type<"text/plain; charset=us-ascii"> {}, ascii_body) == true);
+	static_assert(validate_body(static_media_type<"text/plain; charset=us-ascii"> {}, utf_8_body) == false);
+	static_assert(validate_body(static_media_type<"Text/HTML; Charset=\"UTF-8\""> {}, utf_8_body) == true);
+	static_assert(validate_body(static_media_type<"Text/HTML; Charset=\"UTF-8\""> {}, latin_1_body) == false);
+	static_assert(validate_body(static_media_type<"text/plain; charset=iso-8859-1"> {}, latin_1_body) == std::nullopt);
+	static_assert(validate_body(static_media_type<"application/json"> {}, latin_1_body) == std::nullopt);
+
+	/* At run time the vectorised validators are taken, and agree with the dispatch through a view. */
+	for (const auto body : {ascii_body, utf_8_body, latin_1_body})
+	{
+		EXPECT_EQ(validate_body(static_media_type<"text/plain; charset=utf-8"> {}, body),
+				  validate_body(media_type_view {"text/plain; charset=utf-8"}, body));
+		EXPECT_EQ(validate_body(static_media_type<"text/plain; charset=us-ascii"> {}, body),
+				  validate_body(media_type_view {"text/plain; charset=us-ascii"}, body));
+	}
+}
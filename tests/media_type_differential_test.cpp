@@ -0,0 +1,135 @@
+#include "baseline_media_type.hpp"
+#include "content_types.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Characters meaningful to the grammar, a few invalid ones, and both casings.
+	constexpr std::string_view alphabet {"aZ0/.+-!#$&^_ %*\t"};
+
+	/// @brief Parse with the baseline and with `try_parse`, and expect the same decision, the same error and the same components.
+	/// @brief The baseline ignores parameters, so only input without ';' is compared.
+	void expect_same_as_baseline(const std::string& input)
+	{
+		ASSERT_EQ(input.find(';'), std::string::npos);
+
+		const auto result = media_type::try_parse(input);
+		const auto view = media_type_view::try_parse(input);
+
+		try
+		{
+			const baseline::media_type expected {input};
+
+			ASSERT_TRUE(result) << '"' << input << "\" rejected with " << media_type::message(result.error());
+			EXPECT_EQ(result->string(), expected.string()) << input;
+			EXPECT_EQ(result->type(), expected.type()) << input;
+			EXPECT_EQ(result->tree(), expected.tree()) << input;
+			EXPECT_EQ(result->subtype(), expected.subtype()) << input;
+			EXPECT_EQ(result->suffix(), expected.suffix()) << input;
+			EXPECT_EQ(result->in_standards_tree(), expected.in_standards_tree()) << input;
+
+			ASSERT_TRUE(view) << input;
+			EXPECT_EQ(*view, *result) << input;
+			EXPECT_EQ(view->tree().size(), expected.tree().size()) << input;
+			EXPECT_EQ(view->suffix().size(), expected.suffix().size()) << input;
+		}
+		catch (const baseline::media_type::parsing_error& error)
+		{
+			ASSERT_FALSE(result) << '"' << input << "\" accepted, baseline: " << error.what();
+			EXPECT_STREQ(media_type::message(result.error()), error.what()) << input;
+
+			ASSERT_FALSE(view) << input;
+			EXPECT_EQ(view.error(), result.error()) << input;
+		}
+	}
+
+	/// @brief Every string over the alphabet up to length `remaining`, appended to `input`.
+	void enumerate(std::string& input, const std::size_t remaining)
+	{
+		expect_same_as_baseline(input);
+
+		if (remaining)
+		{
+			for (const auto character : alphabet)
+			{
+				input.push_back(character);
+				enumerate(input, remaining - 1);
+				input.pop_back();
+			}
+		}
+	}
+}
+
+TEST(media_type_differential, corpus)
+{
+	for (const auto type : corpus::content_types)
+	{
+		expect_same_as_baseline(std::string {type.substr(0, type.find(';'))});
+	}
+
+	for (const auto type : corpus::malformed_content_types)
+	{
+		expect_same_as_baseline(std::string {type.substr(0, type.find(';'))});
+	}
+}
+
+TEST(media_type_differential, every_short_string)
+{
+	std::string input {};
+
+	enumerate(input, 4);
+}
+
+TEST(media_type_differential, mutated_corpus)
+{
+	std::mt19937 generator {6838};
+
+	for (std::size_t round {}; round < 20000; ++round)
+	{
+		const auto type = corpus::content_types[generator() % corpus::content_types.size()];
+		std::string input {type.substr(0, type.find(';'))};
+
+		for (auto edits = generator() % 4; edits; --edits)
+		{
+			const auto position = input.empty() ? 0 : generator() % (input.size() + 1);
+			const auto character = alphabet[generator() % alphabet.size()];
+
+			if (const auto edit = generator() % 3; edit == 0 or position == input.size())
+			{
+				input.insert(position, 1, character);
+			}
+			else if (edit == 1)
+			{
+				input[position] = character;
+			}
+			else
+			{
+				input.erase(position, 1);
+			}
+		}
+
+		expect_same_as_baseline(input);
+	}
+}
+
+TEST(media_type_differential, component_length_limits)
+{
+	for (const std::size_t length : {1u, 126u, 127u, 128u})
+	{
+		const std::string name(length, 'a');
+
+		expect_same_as_baseline(name + "/html");
+		expect_same_as_baseline("text/" + name);
+		expect_same_as_baseline("text/" + name + ".html");
+		expect_same_as_baseline("text/html+" + name);
+	}
+}
@@ -0,0 +1,30 @@
+/* Only the media type header, as it has to bring the definitions of the extension lookups it declares. */
+#include "headers/media_type.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+
+using namespace common_good;
+
+TEST(media_type_extension, from_extension)
+{
+	EXPECT_EQ(media_type::from_extension("png")->string(), "image/png");
+	EXPECT_EQ(media_type::from_extension(".JPG")->string(), "image/jpeg");
+	EXPECT_EQ(media_type::from_extension("Html")->string(), "text/html");
+	EXPECT_FALSE(media_type::from_extension("no-such-extension"));
+	EXPECT_FALSE(media_type::from_extension(""));
+}
+
+TEST(media_type_extension, preferred_extension)
+{
+	EXPECT_EQ(media_type {"image/jpeg"}.preferred_extension(), "jpeg");
+	EXPECT_EQ(media_type {"Application/JSON; charset=utf-8"}.preferred_extension(), "json");
+	EXPECT_EQ(media_type_view {"Text/HTML"}.preferred_extension(), "html");
+	EXPECT_EQ(media_type {"application/vnd.no-such-type"}.preferred_extension(), std::nullopt);
+}
+
+TEST(media_type_extension, constant_evaluation)
+{
+	static_assert(media_type::from_extension("png")->string() == "image/png");
+	static_assert(media_type_view {"image/png"}.preferred_extension() == "png");
+}
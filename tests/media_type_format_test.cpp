@@ -0,0 +1,95 @@
+#include "headers/compact_media_type.hpp"
+#include "headers/fixed_media_type.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+#include "headers/static_media_type.hpp"
+
+#include <format>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	constexpr std::string_view header {"Application/Vnd.Api+JSON; Charset=UTF-8"};
+}
+
+TEST(media_type_format, empty_and_string_spec_write_media_type)
+{
+	const media_type type {header};
+
+	EXPECT_EQ(std::format("{}", type), "application/vnd.api+json");
+	EXPECT_EQ(std::format("{:s}", type), "application/vnd.api+json");
+	EXPECT_EQ(std::format("[{:>26}]", type), "[  application/vnd.api+json]");
+	EXPECT_EQ(std::format("[{:*<{}}]", type, 26), "[application/vnd.api+json**]");
+}
+
+TEST(media_type_format, components)
+{
+	const media_type type {header};
+
+	EXPECT_EQ(std::format("{:t}", type), "application");
+	EXPECT_EQ(std::format("{:r}", type), "vnd.");
+	EXPECT_EQ(std::format("{:u}", type), "api");
+	EXPECT_EQ(std::format("{:y}", type), "+json");
+	EXPECT_EQ(std::format("{:w}", type), "application/vnd.api+json;charset=UTF-8");
+	EXPECT_EQ(std::format("{:w}", media_type {"text/plain"}), "text/plain");
+}
+
+TEST(media_type_format, component_takes_string_spec)
+{
+	const media_type type {header};
+
+	EXPECT_EQ(std::format("[{:t:>12}]", type), "[ application]");
+	EXPECT_EQ(std::format("[{:u:-^7}]", type), "[--api--]");
+	EXPECT_EQ(std::format("[{:t:}]", type), "[application]");
+}
+
+TEST(media_type_format, component_takes_dynamic_width)
+{
+	const media_type type {header};
+
+	EXPECT_EQ(std::format("[{:t:>{}}] {}", type, 13, 7), "[  application] 7");
+	EXPECT_EQ(std::format("{:y:<{}}|{:u}", type, 6, type), "+json |api");
+}
+
+TEST(media_type_format, parameters_take_no_spec)
+{
+	const media_type type {header};
+
+	EXPECT_THROW(static_cast<void>(std::vformat("{:w:>40}", std::make_format_args(type))), std::format_error);
+}
+
+TEST(media_type_format, every_class)
+{
+	std::pmr::monotonic_buffer_resource resource {};
+	const pmr::media_type pmr_type {header, &resource};
+	const compact_media_type compact {header};
+	const fixed_media_type<> fixed {header};
+	const media_type_view view {header};
+	const static_media_type<"Application/Vnd.Api+JSON; Charset=UTF-8"> literal {};
+
+	EXPECT_EQ(std::format("{:u} {:w}", pmr_type, pmr_type), "api application/vnd.api+json;charset=UTF-8");
+	EXPECT_EQ(std::format("{:u} {:w}", compact, compact), "api application/vnd.api+json;charset=UTF-8");
+	EXPECT_EQ(std::format("{:u} {:w}", fixed, fixed), "api application/vnd.api+json;charset=UTF-8");
+	EXPECT_EQ(std::format("{:u} {:w}", literal, literal), "api application/vnd.api+json;charset=UTF-8");
+
+	/* A view keeps the original casing of everything it writes, except parameter names. */
+	EXPECT_EQ(std::format("{:s}", view), "Application/Vnd.Api+JSON");
+	EXPECT_EQ(std::format("{:w}", view), "Application/Vnd.Api+JSON;charset=UTF-8");
+}
+
+TEST(media_type_format, appends_to_reserved_buffer)
+{
+	const media_type type {header};
+	std::string buffer {"Content-Type: "};
+	buffer.reserve(64);
+
+	std::format_to(std::back_inserter(buffer), "{:w}\r\n", type);
+
+	EXPECT_EQ(buffer, "Content-Type: application/vnd.api+json;charset=UTF-8\r\n");
+}
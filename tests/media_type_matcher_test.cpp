@@ -0,0 +1,119 @@
+#include "headers/media_type_matcher.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Value of the pattern matching type, or nothing.
+	auto route(const media_type_matcher<std::string>& matcher, const std::string_view type) -> std::optional<std::string>
+	{
+		if (const auto* const result = matcher.find(media_type_view {type}))
+		{
+			return *result;
+		}
+
+		return std::nullopt;
+	}
+
+	/// @brief Reason pattern fail to insert.
+	auto rejection(const std::string_view pattern) -> std::optional<media_type::error>
+	{
+		try
+		{
+			media_type_matcher<int> matcher {};
+			matcher.insert(pattern, 0);
+			return std::nullopt;
+		}
+		catch (const media_type::parsing_error& error)
+		{
+			return error.code();
+		}
+	}
+}
+
+TEST(media_type_matcher, most_specific_pattern_wins)
+{
+	media_type_matcher<std::string> matcher {};
+	matcher.insert("*/*", "any");
+	matcher.insert("application/*", "application");
+	matcher.insert("*/*+json", "json");
+	matcher.insert("application/vnd.foo.*", "foo");
+	matcher.insert("application/vnd.foo.bar+json", "exact");
+
+	EXPECT_EQ(route(matcher, "application/vnd.foo.bar+json"), "exact");
+	EXPECT_EQ(route(matcher, "application/vnd.foo.baz+json"), "foo");
+	EXPECT_EQ(route(matcher, "application/problem+json"), "json");
+	EXPECT_EQ(route(matcher, "text/event+json"), "json");
+	EXPECT_EQ(route(matcher, "application/pdf"), "application");
+	EXPECT_EQ(route(matcher, "image/png"), "any");
+}
+
+TEST(media_type_matcher, longer_prefix_and_suffix_win)
+{
+	media_type_matcher<std::string> matcher {};
+	matcher.insert("text/*", "text");
+	matcher.insert("text/x-*", "x");
+	matcher.insert("text/x-*+xml", "x xml");
+	matcher.insert("text/*+xml", "xml");
+
+	EXPECT_EQ(route(matcher, "text/plain"), "text");
+	EXPECT_EQ(route(matcher, "text/x-custom"), "x");
+	EXPECT_EQ(route(matcher, "text/x-custom+xml"), "x xml");
+	EXPECT_EQ(route(matcher, "text/custom+xml"), "xml");
+	EXPECT_EQ(route(matcher, "image/png"), std::nullopt);
+}
+
+TEST(media_type_matcher, ignores_case)
+{
+	media_type_matcher<std::string> matcher {};
+	matcher.insert("Application/VND.Foo.*", "foo");
+	matcher.insert("*/*+JSON", "json");
+	matcher.insert("TEXT/HTML", "html");
+
+	EXPECT_EQ(route(matcher, "application/vnd.foo.bar"), "foo");
+	EXPECT_EQ(route(matcher, "APPLICATION/Vnd.FOO.bar"), "foo");
+	EXPECT_EQ(route(matcher, "Image/Geo+Json"), "json");
+	EXPECT_EQ(route(matcher, "text/Html"), "html");
+}
+
+TEST(media_type_matcher, equal_pattern_replaces_value)
+{
+	media_type_matcher<std::string> matcher {};
+	matcher.insert("text/*", "first");
+	matcher.insert("TEXT/*", "second");
+	matcher.insert("text/html", "first");
+	matcher.insert("text/html;charset=utf-8", "second");
+
+	EXPECT_EQ(matcher.size(), 2);
+	EXPECT_EQ(route(matcher, "text/plain"), "second");
+	EXPECT_EQ(route(matcher, "text/html"), "second");
+}
+
+TEST(media_type_matcher, ignores_parameters)
+{
+	media_type_matcher<std::string> matcher {};
+	matcher.insert("text/html;q=*", "html");
+	matcher.insert("text/plain;a=\"*x\"", "plain");
+	matcher.insert("image/* ; q=0.5", "image");
+
+	EXPECT_EQ(route(matcher, "text/html"), "html");
+	EXPECT_EQ(route(matcher, "text/plain;a=b"), "plain");
+	EXPECT_EQ(route(matcher, "image/png"), "image");
+}
+
+TEST(media_type_matcher, rejects_malformed_patterns)
+{
+	EXPECT_EQ(rejection("text"), media_type::error::missing_slash);
+	EXPECT_EQ(rejection("text;a=/"), media_type::error::missing_slash);
+	EXPECT_EQ(rejection("text/*html"), media_type::error::subtype_character);
+	EXPECT_EQ(rejection("text/ht*ml"), media_type::error::subtype_character);
+	EXPECT_EQ(rejection("te(t/*"), media_type::error::type_character);
+	EXPECT_EQ(rejection("text/*+"), media_type::error::suffix_length);
+	EXPECT_EQ(rejection("text/html;=x"), media_type::error::parameter_name);
+	EXPECT_EQ(rejection("text/*;q=*"), std::nullopt);
+}
@@ -0,0 +1,89 @@
+#include "headers/media_type.hpp"
+#include "headers/media_type_parser.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Parse through every entry point and expect the same result from each.
+	void expect_rejected(const std::string_view type, const media_type::error expected)
+	{
+		const auto owning = media_type::try_parse(type);
+		ASSERT_FALSE(owning) << type;
+		EXPECT_EQ(owning.error(), expected) << type;
+
+		const auto view = media_type_view::try_parse(type);
+		ASSERT_FALSE(view) << type;
+		EXPECT_EQ(view.error(), expected) << type;
+
+		try
+		{
+			static_cast<void>(media_type {type});
+			ADD_FAILURE() << type << " constructed";
+		}
+		catch (const media_type::parsing_error& error)
+		{
+			EXPECT_EQ(error.code(), expected) << type;
+		}
+
+		media_type_parser parser {};
+
+		for (const auto character : type)
+		{
+			parser.feed({&character, 1});
+		}
+
+		const auto incremental = std::move(parser).finish();
+		ASSERT_FALSE(incremental) << type;
+		EXPECT_EQ(incremental.error(), expected) << type;
+	}
+}
+
+TEST(media_type_parameters, values_and_names)
+{
+	const media_type type {"Text/HTML; Charset=UTF-8; Level=\"1 \\\"a\\\"\""};
+
+	EXPECT_EQ(type.string(), "text/html");
+	EXPECT_EQ(type.parameter("charset"), "UTF-8");
+	EXPECT_EQ(type.parameter("LEVEL"), "1 \\\"a\\\"");
+	EXPECT_EQ(type.parameter("boundary"), std::nullopt);
+	EXPECT_EQ(type.parameters().size(), 2u);
+
+	const media_type_view view {"Text/HTML; Charset=UTF-8"};
+
+	EXPECT_EQ(view.parameter("CHARSET"), "UTF-8");
+	EXPECT_EQ(view.parameters_string(), " Charset=UTF-8");
+}
+
+TEST(media_type_parameters, spills_past_inline_capacity)
+{
+	const media_type type {"a/b;p1=1;p2=2;p3=3;p4=4;p5=5;p6=6"};
+
+	EXPECT_EQ(type.parameters().size(), 6u);
+	EXPECT_EQ(type.parameter("p6"), "6");
+}
+
+TEST(media_type_parameters, tolerates_empty_parameters_and_whitespace)
+{
+	EXPECT_TRUE(media_type::try_parse("text/plain;"));
+	EXPECT_TRUE(media_type::try_parse("text/plain;;a=b"));
+	EXPECT_TRUE(media_type::try_parse("text/plain ;a=b"));
+	EXPECT_TRUE(media_type::try_parse("text/plain; a=b ;"));
+}
+
+/* Breaking change: before parameter support everything after ';' was dropped, so these used to parse as their type alone. */
+TEST(media_type_parameters, malformed_parameter_rejects_media_type)
+{
+	expect_rejected("text/html;foo", media_type::error::parameter_missing_equals);
+	expect_rejected("text/html; charset", media_type::error::parameter_missing_equals);
+	expect_rejected("text/html;=utf-8", media_type::error::parameter_name);
+	expect_rejected("text/html;charset=", media_type::error::parameter_value);
+	expect_rejected("text/html;charset=\"utf-8", media_type::error::parameter_unterminated_quote);
+	expect_rejected("text/html;charset=utf-8 x", media_type::error::parameter_missing_semicolon);
+}
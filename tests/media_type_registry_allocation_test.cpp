@@ -0,0 +1,103 @@
+#include "headers/media_type_registry.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <string>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Allocations left before the next throws, or none to never fail. Counted only on the thread arming it.
+	thread_local long allocations_left {-1};
+}
+
+auto operator new(const std::size_t size) -> void*
+{
+	if (allocations_left == 0)
+	{
+		throw std::bad_alloc {};
+	}
+
+	if (allocations_left > 0)
+	{
+		--allocations_left;
+	}
+
+	if (auto* const memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc {};
+}
+
+/* The replacement pairs malloc with free, which GCC cannot tell once inlined into a delete expression. */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* const memory) noexcept { std::free(memory); }
+
+void operator delete(void* const memory, std::size_t) noexcept { std::free(memory); }
+
+#pragma GCC diagnostic pop
+
+namespace
+{
+	/// @brief Intern type failing its allocation after the given count, telling if it threw.
+	auto intern_failing_after(media_type_registry& registry, const std::string& type, const long allocations) -> bool
+	{
+		const media_type_view view {type};
+		allocations_left = allocations;
+
+		try
+		{
+			static_cast<void>(registry.intern(view));
+			allocations_left = -1;
+			return false;
+		}
+		catch (const std::bad_alloc&)
+		{
+			allocations_left = -1;
+			return true;
+		}
+	}
+}
+
+TEST(media_type_registry, failed_intern_takes_no_identifier)
+{
+	/* Interning before each directory segment boundary, so failing allocations include that of the segment. */
+	for (const std::size_t interned : {0, 63, 64, 191, 192})
+	{
+		media_type_registry registry {};
+
+		for (std::size_t index {}; index < interned; ++index)
+		{
+			const auto name = "application/x-" + std::to_string(index);
+			static_cast<void>(registry.intern(media_type_view {name}));
+		}
+
+		const std::string type {"text/x-failing"};
+		const auto size = registry.size();
+		long allocations {};
+
+		while (intern_failing_after(registry, type, allocations))
+		{
+			EXPECT_EQ(registry.size(), size) << interned << " interned, failing allocation " << allocations;
+			EXPECT_FALSE(registry.find(media_type_view {type})) << interned << " interned, failing allocation " << allocations;
+			++allocations;
+		}
+
+		/* The type interned once allocations succeed takes the next identifier, and is both found and published. */
+		const auto identifier = registry.find(media_type_view {type});
+
+		ASSERT_TRUE(identifier) << interned << " interned";
+		EXPECT_EQ(identifier->id(), size);
+		EXPECT_EQ(registry.size(), size + 1);
+		EXPECT_EQ(registry.view(*identifier).string(), type);
+		EXPECT_EQ(registry.intern(media_type_view {"text/x-after"}).id(), size + 1);
+		EXPECT_EQ(registry.size(), size + 2);
+	}
+}
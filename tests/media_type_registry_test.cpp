@@ -0,0 +1,102 @@
+#include "headers/media_type_registry.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace common_good;
+
+TEST(media_type_registry, well_known_types_are_preseeded)
+{
+	const media_type_registry registry {};
+
+	EXPECT_EQ(registry.size(), media_type_registry::well_known.size());
+	EXPECT_EQ(registry.find(media_type_view {"Text/HTML"}), media_type_registry::well_known_id("text/html"));
+	EXPECT_EQ(registry.view(media_type_registry::well_known_id("text/html")).string(), "text/html");
+	EXPECT_FALSE(registry.find(media_type_view {"text/x-unknown"}));
+}
+
+TEST(media_type_registry, interns_ignoring_case)
+{
+	media_type_registry registry {};
+
+	const auto type = registry.intern(media_type_view {"Text/X-Custom"});
+
+	EXPECT_EQ(registry.intern(media_type_view {"text/x-custom"}), type);
+	EXPECT_EQ(registry.find(media_type_view {"TEXT/X-CUSTOM"}), type);
+	EXPECT_EQ(registry.view(type).string(), "text/x-custom");
+	EXPECT_EQ(registry.size(), media_type_registry::well_known.size() + 1);
+	EXPECT_EQ(type.id(), media_type_registry::well_known.size());
+}
+
+TEST(media_type_registry, identifiers_stay_dense_across_segments)
+{
+	media_type_registry registry {};
+
+	for (std::size_t index {}; index < 1000; ++index)
+	{
+		const auto name = "application/x-" + std::to_string(index);
+		const auto type = registry.intern(media_type_view {name});
+
+		EXPECT_EQ(type.id(), media_type_registry::well_known.size() + index);
+	}
+
+	EXPECT_EQ(registry.view(registry.intern(media_type_view {"application/x-999"})).string(), "application/x-999");
+}
+
+TEST(media_type_registry, every_counted_identifier_can_be_viewed_while_interning)
+{
+	constexpr std::size_t writers {4};
+	constexpr std::size_t types_per_writer {2000};
+
+	media_type_registry registry {};
+	std::atomic<bool> done {};
+	std::atomic<std::size_t> unviewable {};
+
+	std::thread reader {[&]
+	{
+		while (not done.load())
+		{
+			const auto size = registry.size();
+
+			/* Every identifier below the size, as a dispatch table indexed by `id()` would hold them. */
+			for (auto identifier = static_cast<std::uint32_t>(media_type_registry::well_known.size()); identifier < size; ++identifier)
+			{
+				if (registry.view(std::bit_cast<interned_media_type>(identifier)).string().empty())
+				{
+					unviewable.fetch_add(1);
+				}
+			}
+		}
+	}};
+
+	std::vector<std::thread> threads {};
+
+	for (std::size_t writer {}; writer < writers; ++writer)
+	{
+		threads.emplace_back([&, writer]
+		{
+			for (std::size_t index {}; index < types_per_writer; ++index)
+			{
+				const auto name = "application/x-" + std::to_string(writer) + "-" + std::to_string(index);
+				static_cast<void>(registry.intern(media_type_view {name}));
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	done.store(true);
+	reader.join();
+
+	EXPECT_EQ(unviewable.load(), 0);
+	EXPECT_EQ(registry.size(), media_type_registry::well_known.size() + writers * types_per_writer);
+}
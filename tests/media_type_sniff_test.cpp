@@ -0,0 +1,89 @@
+#include "headers/media_type_sniff.hpp"
+
+#include <array>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+using namespace std::literals;
+
+namespace
+{
+	auto sniffed(const std::string_view resource, const bool scriptable = true) -> std::string
+	{ return std::string {sniff(std::as_bytes(std::span {resource.data(), resource.size()}), scriptable).string()}; }
+}
+
+TEST(media_type_sniff, scriptable)
+{
+	EXPECT_EQ(sniffed("  \n<!doctype html><html>"), "text/html");
+	EXPECT_EQ(sniffed("<p>hi"), "text/html");
+	EXPECT_EQ(sniffed("<br "), "text/html");
+	EXPECT_EQ(sniffed("<br"), "text/plain");
+	EXPECT_EQ(sniffed("<htmlx>"), "text/plain");
+	EXPECT_EQ(sniffed("<?xml version"), "text/xml");
+	EXPECT_EQ(sniffed("%PDF-1.7"), "application/pdf");
+	EXPECT_EQ(sniffed(" %PDF-1.7"), "text/plain");
+	EXPECT_EQ(sniffed("<p>", false), "text/plain");
+}
+
+TEST(media_type_sniff, images_audio_and_archives)
+{
+	EXPECT_EQ(sniffed("\x89PNG\r\n\x1A\n\0\0"sv), "image/png");
+	EXPECT_EQ(sniffed("\xFF\xD8\xFF\xE0"), "image/jpeg");
+	EXPECT_EQ(sniffed("GIF89a...."), "image/gif");
+	EXPECT_EQ(sniffed("RIFF\x10\0\0\0WEBPVP8 "sv), "image/webp");
+	EXPECT_EQ(sniffed("RIFF\x10\0\0\0WAVEfmt "sv), "audio/wave");
+	EXPECT_EQ(sniffed("PK\x03\x04...."), "application/zip");
+	EXPECT_EQ(sniffed("\x1F\x8B\x08\0"sv), "application/x-gzip");
+}
+
+/* 52 61 72 20 1A 07 00, a space where RAR files themselves have '!'. */
+TEST(media_type_sniff, rar_signature_as_standard)
+{
+	EXPECT_EQ(sniffed("Rar \x1A\x07\x00...."sv), "application/x-rar-compressed");
+	EXPECT_EQ(sniffed("Rar!\x1A\x07\x00...."sv), "application/octet-stream");
+}
+
+TEST(media_type_sniff, mp4)
+{
+	EXPECT_EQ(sniffed("\0\0\0\x18" "ftypisom\0\0\0\0isommp41"sv), "video/mp4");
+}
+
+TEST(media_type_sniff, webm)
+{
+	constexpr auto header = "\x1A\x45\xDF\xA3\x9F\x42\x86\x81\x01\x42\x82\x84webm"sv;
+
+	EXPECT_EQ(sniffed(std::string {header} + "\x42\x87"), "video/webm");
+	EXPECT_EQ(sniffed(std::string {"\x1A\x45\xDF\xA3\x9F\x42\x82\x84\0\0webm\x42"sv}), "video/webm");
+
+	/* The standard only matches while 'iter < length - 4', so a DocType ending the resource is not enough. */
+	EXPECT_EQ(sniffed(header), "application/octet-stream");
+}
+
+TEST(media_type_sniff, text_and_binary)
+{
+	EXPECT_EQ(sniffed("hello world\n"), "text/plain");
+	EXPECT_EQ(sniffed("hello\0world"sv), "application/octet-stream");
+	EXPECT_EQ(sniffed("\v<p>"), "application/octet-stream");
+	EXPECT_EQ(sniffed(""), "text/plain");
+
+	/* Only the first 512 bytes are inspected. */
+	std::string resource(600, 'a');
+	resource[520] = '\0';
+	EXPECT_EQ(sniffed(resource), "text/plain");
+	resource[100] = '\x01';
+	EXPECT_EQ(sniffed(resource), "application/octet-stream");
+
+	std::string whitespace(510, ' ');
+	whitespace += "<html>";
+	EXPECT_EQ(sniffed(whitespace), "text/plain");
+}
+
+TEST(media_type_sniff, constant_evaluation)
+{
+	static constexpr std::array pdf {std::byte {0x25}, std::byte {0x50}, std::byte {0x44}, std::byte {0x46}, std::byte {0x2D}};
+	static_assert(sniff(pdf) == "application/pdf");
+}
@@ -0,0 +1,255 @@
+#include "content_types.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <format>
+#include <functional>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Reason type fail to parse, through the throwing constructor.
+	auto rejection(const std::string_view type) -> std::optional<media_type::error>
+	{
+		try
+		{
+			static_cast<void>(media_type {type});
+			return std::nullopt;
+		}
+		catch (const media_type::parsing_error& error)
+		{
+			return error.code();
+		}
+	}
+
+	/// @brief Media types and their suffix and top-level type, in mixed case to show classification ignores it.
+	struct classified
+	{
+		std::string_view type;
+		structured_suffix suffix;
+		top_level_type top_level;
+	};
+
+	constexpr classified classifications[] {
+		{"application/soap+XML", structured_suffix::xml, top_level_type::application},
+		{"application/problem+Json", structured_suffix::json, top_level_type::application},
+		{"application/vnd.x+ber", structured_suffix::ber, top_level_type::application},
+		{"application/vnd.x+CBOR", structured_suffix::cbor, top_level_type::application},
+		{"application/vnd.x+der", structured_suffix::der, top_level_type::application},
+		{"application/vnd.x+FastInfoset", structured_suffix::fastinfoset, top_level_type::application},
+		{"application/vnd.x+wbxml", structured_suffix::wbxml, top_level_type::application},
+		{"application/epub+Zip", structured_suffix::zip, top_level_type::application},
+		{"application/vnd.x+tlv", structured_suffix::tlv, top_level_type::application},
+		{"application/geo+JSON-SEQ", structured_suffix::json_seq, top_level_type::application},
+		{"application/vnd.x+sqlite3", structured_suffix::sqlite3, top_level_type::application},
+		{"application/vnd.x+jwt", structured_suffix::jwt, top_level_type::application},
+		{"application/vnd.x+GZIP", structured_suffix::gzip, top_level_type::application},
+		{"application/vnd.x+cbor-seq", structured_suffix::cbor_seq, top_level_type::application},
+		{"application/vnd.x+zstd", structured_suffix::zstd, top_level_type::application},
+		{"application/vnd.x+Yaml", structured_suffix::yaml, top_level_type::application},
+		/* Unregistered, and registered names only as part of a suffix. */
+		{"application/vnd.x+foo", structured_suffix::other, top_level_type::application},
+		{"application/vnd.x+jsonx", structured_suffix::other, top_level_type::application},
+		{"application/vnd.x+json-seqs", structured_suffix::other, top_level_type::application},
+		{"application/json", structured_suffix::none, top_level_type::application},
+		{"application/a+json+zip; charset=utf-8", structured_suffix::zip, top_level_type::application},
+		{"Audio/OGG", structured_suffix::none, top_level_type::audio},
+		{"example/x", structured_suffix::none, top_level_type::example},
+		{"FONT/woff2", structured_suffix::none, top_level_type::font},
+		{"haptics/ivs", structured_suffix::none, top_level_type::haptics},
+		{"Image/SVG+XML", structured_suffix::xml, top_level_type::image},
+		{"message/rfc822", structured_suffix::none, top_level_type::message},
+		{"model/gltf+json", structured_suffix::json, top_level_type::model},
+		{"Multipart/Form-Data", structured_suffix::none, top_level_type::multipart},
+		{"TEXT/html", structured_suffix::none, top_level_type::text},
+		{"video/MP4", structured_suffix::none, top_level_type::video},
+		{"x-custom/thing+json", structured_suffix::json, top_level_type::other},
+		{"texts/plain", structured_suffix::none, top_level_type::other},
+		{"tex/plain", structured_suffix::none, top_level_type::other},
+	};
+}
+
+TEST(media_type, constructs_from_every_string_source)
+{
+	const std::string owned {"Text/HTML"};
+	std::string temporary {"Text/HTML"};
+
+	const media_type from_rvalue {std::move(temporary)};
+	const media_type from_lvalue {owned};
+	const media_type from_view {std::string_view {owned}};
+	const media_type from_pointer {"Text/HTML"};
+
+	for (const auto* type : {&from_rvalue, &from_lvalue, &from_view, &from_pointer})
+	{
+		EXPECT_EQ(type->string(), "text/html");
+	}
+}
+
+TEST(media_type, accessors)
+{
+	const media_type type {"application/vnd.api+json"};
+
+	EXPECT_EQ(type.type(), "application");
+	EXPECT_EQ(type.tree(), "vnd.");
+	EXPECT_EQ(type.subtype(), "api");
+	EXPECT_EQ(type.suffix(), "+json");
+	EXPECT_FALSE(type.in_standards_tree());
+
+	const media_type standard {"image/svg+xml"};
+
+	EXPECT_EQ(standard.tree(), "");
+	EXPECT_EQ(standard.subtype(), "svg");
+	EXPECT_EQ(standard.suffix(), "+xml");
+	EXPECT_TRUE(standard.in_standards_tree());
+}
+
+TEST(media_type, last_plus_starts_suffix)
+{
+	const media_type type {"application/a+b+json"};
+
+	EXPECT_EQ(type.subtype(), "a+b");
+	EXPECT_EQ(type.suffix(), "+json");
+}
+
+TEST(media_type, lowercases_type)
+{
+	const media_type type {"APPLICATION/VND.API+JSON"};
+
+	EXPECT_EQ(type.string(), "application/vnd.api+json");
+	EXPECT_EQ(type, media_type {"application/vnd.api+json"});
+}
+
+TEST(media_type, accepts_corpus)
+{
+	for (const auto type : corpus::content_types)
+	{
+		EXPECT_FALSE(rejection(type)) << type;
+	}
+}
+
+TEST(media_type, rejects_malformed_corpus)
+{
+	for (const auto type : corpus::malformed_content_types)
+	{
+		EXPECT_TRUE(rejection(type)) << type;
+	}
+}
+
+TEST(media_type, reports_reason)
+{
+	EXPECT_EQ(rejection("text"), media_type::error::missing_slash);
+	EXPECT_EQ(rejection("/html"), media_type::error::type_length);
+	EXPECT_EQ(rejection("-text/html"), media_type::error::type_first_character);
+	EXPECT_EQ(rejection("te(t/html"), media_type::error::type_character);
+	EXPECT_EQ(rejection("text/.html"), media_type::error::missing_tree);
+	EXPECT_EQ(rejection("text/-vnd.html"), media_type::error::tree_first_character);
+	EXPECT_EQ(rejection("text/v+d.html"), media_type::error::tree_character);
+	EXPECT_EQ(rejection("text/"), media_type::error::subtype_length);
+	EXPECT_EQ(rejection("text/vnd.-html"), media_type::error::subtype_first_character);
+	EXPECT_EQ(rejection("text/ht ml"), media_type::error::subtype_character);
+	EXPECT_EQ(rejection("text/html+"), media_type::error::suffix_length);
+	EXPECT_EQ(rejection("text/html+-json"), media_type::error::suffix_second_character);
+	EXPECT_EQ(rejection("text/vnd.html+js.on"), media_type::error::suffix_character);
+	EXPECT_EQ(rejection(std::string(128, 'a') + "/html"), media_type::error::type_length);
+	EXPECT_EQ(rejection("text/" + std::string(128, 'a')), media_type::error::subtype_length);
+}
+
+TEST(media_type, parsing_error_message)
+{
+	try
+	{
+		static_cast<void>(media_type {"text"});
+		FAIL();
+	}
+	catch (const media_type::parsing_error& error)
+	{
+		EXPECT_STREQ(error.what(), media_type::message(media_type::error::missing_slash));
+	}
+}
+
+TEST(media_type, classifies_suffix_and_top_level_type)
+{
+	for (const auto& [string, suffix, top_level] : classifications)
+	{
+		const media_type type {string};
+		const media_type_view view {string};
+
+		EXPECT_EQ(type.structured_suffix(), suffix) << string;
+		EXPECT_EQ(type.top_level_type(), top_level) << string;
+		EXPECT_EQ(view.structured_suffix(), suffix) << string;
+		EXPECT_EQ(view.top_level_type(), top_level) << string;
+	}
+
+	static_assert(media_type_view {"Application/LD+JSON"}.structured_suffix() == structured_suffix::json);
+	static_assert(media_type_view {"Application/LD+JSON"}.top_level_type() == top_level_type::application);
+}
+
+TEST(media_type, compares_ignoring_case)
+{
+	const media_type type {"text/html"};
+
+	EXPECT_EQ(type, "TEXT/html");
+	EXPECT_EQ(type, std::string_view {"Text/Html"});
+	EXPECT_EQ(type, std::string {"text/HTML"});
+	EXPECT_NE(type, "text/plain");
+}
+
+TEST(media_type, hash_agrees_across_type_view_and_string)
+{
+	for (const std::string_view string : {"text/html", "Text/HTML", "application/VND.api+JSON", "image/svg+xml; charset=utf-8"})
+	{
+		const media_type type {string};
+		const media_type_view view {string};
+		std::string uppercase {view.string()};
+		ascii::to_uppercase_in_place(uppercase);
+
+		const auto expected = std::hash<media_type> {}(type);
+
+		EXPECT_EQ(type.hash(), expected) << string;
+		EXPECT_EQ(std::hash<media_type> {}(view), expected) << string;
+		EXPECT_EQ(std::hash<media_type_view> {}(view), expected) << string;
+		EXPECT_EQ(std::hash<media_type> {}(view.string()), expected) << string;
+		EXPECT_EQ(std::hash<media_type> {}(std::string_view {type.string()}), expected) << string;
+		EXPECT_EQ(std::hash<media_type> {}(std::string_view {uppercase}), expected) << string;
+	}
+
+	EXPECT_NE(std::hash<media_type> {}(media_type {"text/html"}), std::hash<media_type> {}(media_type {"text/plain"}));
+}
+
+TEST(media_type, unordered_set_finds_by_view_and_string)
+{
+	const std::unordered_set<media_type, std::hash<media_type>, std::equal_to<>> types {
+		media_type {"text/html"}, media_type {"Application/JSON"}, media_type {"image/svg+xml"}};
+
+	const std::string json {"application/json"};
+	const std::string svg {"Image/SVG+XML; charset=utf-8"};
+
+	EXPECT_TRUE(types.contains(std::string_view {"TEXT/Html"}));
+	EXPECT_TRUE(types.contains(std::string_view {json}));
+	EXPECT_TRUE(types.contains(media_type_view {svg}));
+	EXPECT_TRUE(types.contains(media_type {"Text/HTML"}));
+	EXPECT_EQ(types.find(media_type_view {json})->string(), "application/json");
+
+	EXPECT_FALSE(types.contains(std::string_view {"text/plain"}));
+	EXPECT_FALSE(types.contains(media_type_view {"text/html+xml"}));
+	EXPECT_EQ(types.count(std::string_view {"IMAGE/SVG+XML"}), 1);
+}
+
+TEST(media_type, formats_as_string)
+{
+	const media_type type {"Text/HTML"};
+
+	EXPECT_EQ(std::format("{}", type), "text/html");
+	EXPECT_EQ(std::format("<{}>", type), "<text/html>");
+}
+
+TEST(media_type, literal)
+{
+	EXPECT_EQ("Image/PNG"_media_type.string(), "image/png");
+}
@@ -0,0 +1,56 @@
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+using namespace common_good;
+
+/* A view of a temporary would dangle as soon as the full-expression ends. */
+static_assert(std::is_constructible_v<media_type_view, const media_type&>);
+static_assert(std::is_constructible_v<media_type_view, const pmr::media_type&>);
+static_assert(not std::is_constructible_v<media_type_view, media_type&&>);
+static_assert(not std::is_constructible_v<media_type_view, pmr::media_type&&>);
+static_assert(not std::is_constructible_v<media_type_view, std::string&&>);
+static_assert(std::is_constructible_v<media_type_view, const std::string&>);
+
+TEST(media_type_view, keeps_original_casing)
+{
+	const std::string header {"Application/Vnd.API+JSON; Charset=UTF-8"};
+	const media_type_view view {header};
+
+	EXPECT_EQ(view.string(), "Application/Vnd.API+JSON");
+	EXPECT_EQ(view.type(), "Application");
+	EXPECT_EQ(view.tree(), "Vnd.");
+	EXPECT_EQ(view.subtype(), "API");
+	EXPECT_EQ(view.suffix(), "+JSON");
+	EXPECT_EQ(view.parameter("charset"), "UTF-8");
+	EXPECT_EQ(view, "application/vnd.api+json");
+}
+
+TEST(media_type_view, of_owning_media_type)
+{
+	const media_type type {"Text/HTML; Charset=UTF-8"};
+	const media_type_view view {type};
+
+	EXPECT_EQ(view.string().data(), type.string().data());
+	EXPECT_EQ(view, type);
+	EXPECT_EQ(view.parameter("charset"), "UTF-8");
+}
+
+TEST(media_type_view, owning_copy_across_allocators)
+{
+	std::pmr::monotonic_buffer_resource arena {};
+	const media_type type {"Text/HTML; Charset=UTF-8"};
+
+	const pmr::media_type in_arena {type, &arena};
+	const media_type back {in_arena};
+
+	EXPECT_EQ(in_arena, type);
+	EXPECT_EQ(in_arena.parameter("charset"), "UTF-8");
+	EXPECT_EQ(back, type);
+	EXPECT_EQ(back.parameter("charset"), "UTF-8");
+}
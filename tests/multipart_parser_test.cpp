@@ -0,0 +1,218 @@
+#include "headers/multipart_parser.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Everything the visitor saw of a part, copied as its views are valid during the call only.
+	struct received
+	{
+		std::string headers;
+		std::optional<std::string> content_type;
+		std::optional<std::string> charset;
+		std::string data;
+		std::size_t completions {};
+
+		auto operator==(const received&) const -> bool = default;
+	};
+
+	struct outcome
+	{
+		std::vector<received> parts;
+		std::optional<multipart_parser::error> failure;
+
+		auto operator==(const outcome&) const -> bool = default;
+	};
+
+	/// @brief Feed body in chunks ending at the given offsets, then the rest.
+	auto parse(const std::string_view type, const std::string_view body, const std::vector<std::size_t>& splits,
+			   const std::size_t header_limit = 8192) -> outcome
+	{
+		multipart_parser parser {media_type_view {type}, header_limit};
+		outcome result {};
+
+		auto visitor = [&](const multipart_part& part, const std::string_view data, const bool complete)
+		{
+			if (part.index() == result.parts.size())
+			{
+				auto& added = result.parts.emplace_back();
+				added.headers = part.headers();
+
+				if (const auto content_type = part.content_type())
+				{
+					added.content_type = std::string {content_type->string()};
+
+					if (const auto charset = content_type->parameter("charset"))
+					{
+						added.charset = std::string {*charset};
+					}
+				}
+			}
+
+			ASSERT_LT(part.index(), result.parts.size());
+			result.parts[part.index()].data.append(data);
+			result.parts[part.index()].completions += complete ? 1 : 0;
+		};
+
+		std::size_t first {};
+
+		for (const auto split : splits)
+		{
+			parser.feed(body.substr(first, split - first), visitor);
+			first = split;
+		}
+
+		parser.feed(body.substr(first), visitor);
+
+		if (const auto finished = parser.finish(); not finished)
+		{
+			result.failure = finished.error();
+		}
+
+		return result;
+	}
+
+	/// @brief Body parsed whole, split at every offset in two, and fed a byte at a time, all expected to agree.
+	auto parse_every_split(const std::string_view type, const std::string_view body, const std::size_t header_limit = 8192) -> outcome
+	{
+		const auto whole = parse(type, body, {}, header_limit);
+
+		for (std::size_t split {}; split <= body.size(); ++split)
+		{
+			EXPECT_EQ(parse(type, body, {split}, header_limit), whole) << "split at " << split;
+		}
+
+		std::vector<std::size_t> bytes {};
+
+		for (std::size_t split {1}; split < body.size(); ++split)
+		{
+			bytes.push_back(split);
+		}
+
+		EXPECT_EQ(parse(type, body, bytes, header_limit), whole) << "a byte at a time";
+		return whole;
+	}
+
+	/// @brief Reason type is refused by the constructor.
+	auto rejection(const std::string_view type) -> std::optional<multipart_parser::error>
+	{
+		try
+		{
+			static_cast<void>(multipart_parser {media_type_view {type}});
+			return std::nullopt;
+		}
+		catch (const multipart_parser::parsing_error& error)
+		{
+			return error.code();
+		}
+	}
+
+	constexpr std::string_view form {"multipart/form-data; boundary=frontier"};
+
+	constexpr std::string_view body {"preamble, --frontier ignored\r\n"
+									 "--frontier \t \r\n"
+									 "Content-Type: Text/Plain; Charset=utf-8\r\n"
+									 "Content-Disposition: form-data; name=\"a\"\r\n"
+									 "\r\n"
+									 "first\r\n--frontie not a delimiter\r\n-- frontier neither"
+									 "\r\n--frontier\r\n"
+									 "\r\n"
+									 "second"
+									 "\r\n--frontier--  \r\n"
+									 "epilogue\r\n--frontier\r\nignored"};
+}
+
+TEST(multipart_parser, splits_body_at_every_chunk_boundary)
+{
+	const auto result = parse_every_split(form, body);
+
+	ASSERT_EQ(result.parts.size(), 2);
+	EXPECT_FALSE(result.failure);
+
+	EXPECT_EQ(result.parts[0].headers, "Content-Type: Text/Plain; Charset=utf-8\r\nContent-Disposition: form-data; name=\"a\"");
+	EXPECT_EQ(result.parts[0].content_type, "Text/Plain");
+	EXPECT_EQ(result.parts[0].charset, "utf-8");
+	EXPECT_EQ(result.parts[0].data, "first\r\n--frontie not a delimiter\r\n-- frontier neither");
+	EXPECT_EQ(result.parts[0].completions, 1);
+
+	EXPECT_EQ(result.parts[1].headers, "");
+	EXPECT_EQ(result.parts[1].content_type, std::nullopt);
+	EXPECT_EQ(result.parts[1].data, "second");
+	EXPECT_EQ(result.parts[1].completions, 1);
+}
+
+TEST(multipart_parser, body_may_begin_with_delimiter)
+{
+	const auto result = parse_every_split(form, "--frontier\r\nContent-Type: image/png\r\n\r\n\x89PNG\r\n--frontier--");
+
+	ASSERT_EQ(result.parts.size(), 1);
+	EXPECT_FALSE(result.failure);
+	EXPECT_EQ(result.parts[0].content_type, "image/png");
+	EXPECT_EQ(result.parts[0].data, "\x89PNG");
+}
+
+TEST(multipart_parser, part_header_lookup)
+{
+	multipart_parser parser {media_type_view {form}};
+	std::optional<std::string> disposition {};
+	std::optional<std::string> missing {};
+
+	parser.feed("--frontier\r\ncontent-DISPOSITION:  form-data; name=x \t\r\n\r\ndata\r\n--frontier--",
+				[&](const multipart_part& part, std::string_view, const bool complete)
+				{
+					if (complete)
+					{
+						disposition = part.header("Content-Disposition");
+						missing = part.header("Content-Type");
+					}
+				});
+
+	EXPECT_EQ(disposition, "form-data; name=x");
+	EXPECT_EQ(missing, std::nullopt);
+	EXPECT_TRUE(parser.finish());
+}
+
+TEST(multipart_parser, truncated_body)
+{
+	for (const auto truncated : {body.substr(0, body.find("\r\n--frontier--")), body.substr(0, body.find("--  \r\n") + 1),
+								 std::string_view {"no delimiter at all"}})
+	{
+		EXPECT_EQ(parse_every_split(form, truncated).failure, multipart_parser::error::truncated) << truncated;
+	}
+}
+
+TEST(multipart_parser, header_limit)
+{
+	const std::string_view headers {"--frontier\r\nContent-Type: text/plain\r\n\r\ndata\r\n--frontier--"};
+
+	EXPECT_FALSE(parse_every_split(form, headers, 28).failure);
+	EXPECT_EQ(parse_every_split(form, headers, 27).failure, multipart_parser::error::header_size);
+}
+
+TEST(multipart_parser, malformed_body)
+{
+	EXPECT_EQ(parse_every_split(form, "--frontierx\r\n\r\n--frontier--").failure, multipart_parser::error::delimiter_padding);
+	EXPECT_EQ(parse_every_split(form, "--frontier \r\r\n\r\n--frontier--").failure, multipart_parser::error::delimiter_padding);
+	EXPECT_EQ(parse_every_split(form, "--frontier-x").failure, multipart_parser::error::delimiter_padding);
+	EXPECT_EQ(parse_every_split(form, "--frontier\r\nno colon\r\n\r\n--frontier--").failure, multipart_parser::error::header_syntax);
+	EXPECT_EQ(parse_every_split(form, "--frontier\r\n: empty name\r\n\r\n--frontier--").failure, multipart_parser::error::header_syntax);
+}
+
+TEST(multipart_parser, rejects_media_type)
+{
+	EXPECT_EQ(rejection("multipart/form-data"), multipart_parser::error::missing_boundary);
+	EXPECT_EQ(rejection("multipart/mixed; charset=utf-8"), multipart_parser::error::missing_boundary);
+	EXPECT_EQ(rejection("text/plain; boundary=frontier"), multipart_parser::error::not_multipart);
+	EXPECT_EQ(rejection("multipart/mixed; boundary=\"\""), multipart_parser::error::boundary_length);
+	EXPECT_EQ(rejection("multipart/mixed; boundary=" + std::string(71, 'b')), multipart_parser::error::boundary_length);
+	EXPECT_EQ(rejection("multipart/mixed; boundary=\"a;b\""), multipart_parser::error::boundary_character);
+	EXPECT_EQ(rejection("multipart/mixed; boundary=\"ends in space \""), multipart_parser::error::boundary_character);
+	EXPECT_EQ(rejection("multipart/mixed; boundary=\"gc0p4Jq0M2Yt08j34c0p\""), std::nullopt);
+}
@@ -0,0 +1,71 @@
+#include "headers/static_media_type.hpp"
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace common_good;
+
+namespace
+{
+	using problem = static_media_type<"Application/Problem+JSON; Charset=UTF-8">;
+
+	static_assert(problem::string() == "application/problem+json");
+	static_assert(problem::type() == "application");
+	static_assert(problem::tree() == "");
+	static_assert(problem::subtype() == "problem");
+	static_assert(problem::suffix() == "+json");
+	static_assert(problem::in_standards_tree());
+	static_assert(problem::parameters_string() == " Charset=UTF-8");
+	static_assert(problem::parameter("charset") == "UTF-8");
+	static_assert(problem::parameter("q") == std::nullopt);
+	static_assert(problem::view().structured_suffix() == structured_suffix::json);
+
+	static_assert("Text/VND.A.B+xml"_static_media_type.tree() == "vnd.");
+	static_assert("Text/VND.A.B+xml"_static_media_type.subtype() == "a.b");
+	static_assert("text/html"_static_media_type == static_media_type<"TEXT/HTML"> {});
+	static_assert(not("text/html"_static_media_type == static_media_type<"text/plain"> {}));
+	static_assert("text/html"_static_media_type == "Text/Html");
+
+	/// @brief A table of views into static storage, in constant initialisation.
+	constinit const media_type_view accepted[] {static_media_type<"text/html">::view(), "Image/PNG"_static_media_type, problem {}};
+}
+
+TEST(static_media_type, constinit_table)
+{
+	EXPECT_EQ(accepted[0].string(), "text/html");
+	EXPECT_EQ(accepted[1].string(), "image/png");
+	EXPECT_EQ(accepted[2].suffix(), "+json");
+	EXPECT_EQ(accepted[2].parameter("charset"), "UTF-8");
+}
+
+TEST(static_media_type, compares_with_runtime_media_type)
+{
+	const std::string header {"application/PROBLEM+json;charset=utf-8"};
+
+	EXPECT_EQ(problem {}, media_type {header});
+	EXPECT_EQ(problem {}, media_type_view {header});
+	EXPECT_EQ(problem {}, std::string_view {header}.substr(0, header.find(';')));
+	EXPECT_FALSE(problem {} == media_type {"application/json"});
+	EXPECT_FALSE("text/html"_static_media_type == media_type_view {header});
+}
+
+TEST(static_media_type, converts_keeping_components)
+{
+	/* Converted from the stored offsets, so every component agrees with parsing the literal at run time. */
+	const auto converted = static_cast<media_type>(problem {});
+	const media_type parsed {"Application/Problem+JSON; Charset=UTF-8"};
+
+	EXPECT_EQ(converted, parsed);
+	EXPECT_EQ(converted.string(), parsed.string());
+	EXPECT_EQ(converted.type(), parsed.type());
+	EXPECT_EQ(converted.subtype(), parsed.subtype());
+	EXPECT_EQ(converted.suffix(), parsed.suffix());
+	EXPECT_EQ(converted.structured_suffix(), parsed.structured_suffix());
+	EXPECT_EQ(converted.parameter("charset"), parsed.parameter("charset"));
+	EXPECT_EQ(converted.hash(), parsed.hash());
+
+	/* The view points into storage of the literal rather than a temporary. */
+	EXPECT_EQ(problem::view().string().data(), problem::string().data());
+}
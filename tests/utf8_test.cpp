@@ -0,0 +1,205 @@
+#include "headers/utf8.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief RFC 3629 validation by decoding each code point, the definition the vectorised validator is compared against.
+	auto decodes(const std::string_view string) -> bool
+	{
+		for (std::size_t index {}; index < string.size();)
+		{
+			const auto lead = static_cast<unsigned char>(string[index]);
+			std::size_t size {};
+			std::uint32_t value {};
+
+			if (lead < 0x80)
+			{
+				size = 1;
+				value = lead;
+			}
+			else if ((lead & 0xE0) == 0xC0)
+			{
+				size = 2;
+				value = lead & 0x1F;
+			}
+			else if ((lead & 0xF0) == 0xE0)
+			{
+				size = 3;
+				value = lead & 0x0F;
+			}
+			else if ((lead & 0xF8) == 0xF0)
+			{
+				size = 4;
+				value = lead & 0x07;
+			}
+			else
+			{
+				return false;
+			}
+
+			if (index + size > string.size())
+			{
+				return false;
+			}
+
+			for (std::size_t offset {1}; offset < size; ++offset)
+			{
+				const auto continuation = static_cast<unsigned char>(string[index + offset]);
+
+				if ((continuation & 0xC0) != 0x80)
+				{
+					return false;
+				}
+
+				value = value << 6 | (continuation & 0x3F);
+			}
+
+			constexpr std::array<std::uint32_t, 5> smallest {0, 0, 0x80, 0x800, 0x10000};
+
+			if (value < smallest[size] or value > 0x10FFFF or (value >= 0xD800 and value <= 0xDFFF))
+			{
+				return false;
+			}
+
+			index += size;
+		}
+
+		return true;
+	}
+
+	/// @brief Sequences at the edges of validity, each alone and as the prefixes that truncate it.
+	const std::vector<std::string> sequences {
+		"a",
+		"\x7F",
+		"\xC2\x80",
+		"\xDF\xBF",
+		"\xE0\xA0\x80",
+		"\xED\x9F\xBF",
+		"\xEE\x80\x80",
+		"\xEF\xBF\xBF",
+		"\xF0\x90\x80\x80",
+		"\xF4\x8F\xBF\xBF",
+		/* Overlong. */
+		"\xC0\x80",
+		"\xC1\xBF",
+		"\xE0\x80\x80",
+		"\xE0\x9F\xBF",
+		"\xF0\x80\x80\x80",
+		"\xF0\x8F\xBF\xBF",
+		/* Surrogates. */
+		"\xED\xA0\x80",
+		"\xED\xBF\xBF",
+		/* Above U+10FFFF. */
+		"\xF4\x90\x80\x80",
+		"\xF5\x80\x80\x80",
+		"\xF7\xBF\xBF\xBF",
+		"\xF8\x88\x80\x80\x80",
+		"\xFF",
+		/* Continuations without lead, and too many. */
+		"\x80",
+		"\xBF",
+		"\xC2\x80\x80",
+		"\xE2\x82\xAC\x80",
+		/* Lead followed by another lead or ascii. */
+		"\xC2\xC2\x80",
+		"\xE2\x82" "a",
+		"\xF0\x9F\x98" "a",
+	};
+}
+
+TEST(utf8, matches_decoder_on_edge_sequences)
+{
+	for (const auto& sequence : sequences)
+	{
+		for (std::size_t size {}; size <= sequence.size(); ++size)
+		{
+			const auto prefix = std::string_view {sequence}.substr(0, size);
+			EXPECT_EQ(utf8::is_valid(prefix), decodes(prefix)) << testing::PrintToString(prefix);
+		}
+	}
+}
+
+TEST(utf8, matches_decoder_across_block_boundaries)
+{
+	/* Every sequence and truncation of it at every offset of buffers up to past two 64-byte blocks, so each straddles the 16, 32 and
+	 * 64-byte boundaries of every vector width and the end of input. */
+	for (const auto& sequence : sequences)
+	{
+		for (std::size_t size {1}; size <= sequence.size(); ++size)
+		{
+			for (const std::size_t length : {15, 16, 17, 31, 32, 33, 63, 64, 65, 128, 130})
+			{
+				for (std::size_t offset {}; offset + size <= length; ++offset)
+				{
+					std::string buffer(length, 'x');
+					buffer.replace(offset, size, sequence, 0, size);
+
+					ASSERT_EQ(utf8::is_valid(buffer), decodes(buffer)) << testing::PrintToString(buffer) << " at " << offset;
+				}
+			}
+		}
+	}
+}
+
+TEST(utf8, matches_decoder_on_valid_text_with_one_corrupted_byte)
+{
+	std::string text {};
+
+	while (text.size() < 200)
+	{
+		text.append("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 ");
+	}
+
+	ASSERT_TRUE(utf8::is_valid(text));
+
+	for (std::size_t index {}; index < text.size(); ++index)
+	{
+		for (const auto replacement : {'\x80', '\xC0', '\xE0', '\xF0', '\xFF', 'a'})
+		{
+			auto corrupted = text;
+			corrupted[index] = replacement;
+
+			ASSERT_EQ(utf8::is_valid(corrupted), decodes(corrupted)) << "byte " << index;
+		}
+	}
+}
+
+TEST(utf8, matches_decoder_on_random_bytes)
+{
+	std::mt19937 generator {2024};
+
+	/* Bytes drawn mostly from lead and continuation ranges, so random strings are often valid for a while. */
+	constexpr std::array<unsigned char, 16> alphabet {'a', ' ', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4};
+
+	for (int count {}; count < 20000; ++count)
+	{
+		std::string random(std::uniform_int_distribution<std::size_t> {0, 100}(generator), ' ');
+
+		for (auto& character : random)
+		{
+			character = static_cast<char>(alphabet[std::uniform_int_distribution<std::size_t> {0, alphabet.size() - 1}(generator)]);
+		}
+
+		ASSERT_EQ(utf8::is_valid(random), decodes(random)) << testing::PrintToString(random);
+	}
+}
+
+TEST(utf8, constant_evaluated)
+{
+	static_assert(utf8::is_valid(""));
+	static_assert(utf8::is_valid("plain ascii and \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"));
+	static_assert(not utf8::is_valid("\xED\xA0\x80"));
+	static_assert(not utf8::is_valid("\xC0\x80"));
+	static_assert(not utf8::is_valid("\xF4\x90\x80\x80"));
+	static_assert(not utf8::is_valid("\xE2\x82"));
+}
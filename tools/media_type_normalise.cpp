@@ -0,0 +1,383 @@
+#include "headers/media_type_batch.hpp"
+#include "headers/media_type_registry.hpp"
+#include "headers/media_type_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace common_good;
+
+namespace
+{
+	/// @brief Read-only mapping of a whole file, unmapped on destruction.
+	class mapped_file
+	{
+		const char* data {};
+		std::size_t size {};
+
+	  public:
+		[[nodiscard]] explicit mapped_file(const char* const path)
+		{
+			const auto descriptor = ::open(path, O_RDONLY);
+
+			if (descriptor < 0)
+			{
+				throw std::runtime_error {std::format("cannot open '{}'", path)};
+			}
+
+			struct stat status {};
+
+			if (::fstat(descriptor, &status) != 0)
+			{
+				::close(descriptor);
+				throw std::runtime_error {std::format("cannot stat '{}'", path)};
+			}
+
+			size = static_cast<std::size_t>(status.st_size);
+
+			if (size != 0)
+			{
+				auto* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+				if (mapping == MAP_FAILED)
+				{
+					::close(descriptor);
+					throw std::runtime_error {std::format("cannot map '{}'", path)};
+				}
+
+				data = static_cast<const char*>(mapping);
+				::madvise(mapping, size, MADV_SEQUENTIAL);
+			}
+
+			/* The mapping outlives the descriptor. */
+			::close(descriptor);
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+		~mapped_file()
+		{
+			if (data)
+			{
+				::munmap(const_cast<char*>(data), size);
+			}
+		}
+
+		[[nodiscard]] auto view() const noexcept -> std::string_view { return {data, size}; }
+	};
+
+	/// @brief Split input into chunks of about the given size, each ending after a newline or at the end of input.
+	[[nodiscard]] auto chunk(const std::string_view input, const std::size_t size) -> std::vector<std::string_view>
+	{
+		std::vector<std::string_view> chunks {};
+
+		for (std::size_t first {}; first < input.size();)
+		{
+			auto last = input.find('\n', std::min(first + size, input.size()) - 1);
+			last = last == std::string_view::npos ? input.size() : last + 1;
+			chunks.push_back(input.substr(first, last - first));
+			first = last;
+		}
+
+		return chunks;
+	}
+
+	/// @brief Fixed set of tasks run by a pool of threads, each taking from the back of its own queue and stealing from the front
+	/// of the others' once empty. No task creates more, so every queue empty means the run is done.
+	class work_stealing_pool
+	{
+		/// @brief Aligned to a cache line of its own, so one queue's lock never shares a line with another's.
+		struct alignas(64) queue
+		{
+			std::mutex mutex;
+			std::deque<std::size_t> tasks;
+		};
+
+		std::vector<queue> queues;
+
+		[[nodiscard]] auto pop(const std::size_t worker) -> std::optional<std::size_t>
+		{
+			{
+				auto& own = queues[worker];
+				const std::lock_guard lock {own.mutex};
+
+				if (not own.tasks.empty())
+				{
+					const auto task = own.tasks.back();
+					own.tasks.pop_back();
+					return task;
+				}
+			}
+
+			for (std::size_t distance {1}; distance < queues.size(); ++distance)
+			{
+				auto& victim = queues[(worker + distance) % queues.size()];
+				const std::lock_guard lock {victim.mutex};
+
+				if (not victim.tasks.empty())
+				{
+					const auto task = victim.tasks.front();
+					victim.tasks.pop_front();
+					return task;
+				}
+			}
+
+			return std::nullopt;
+		}
+
+	  public:
+		[[nodiscard]] explicit work_stealing_pool(const std::size_t workers) : queues(std::max<std::size_t>(workers, 1)) { }
+
+		[[nodiscard]] auto workers() const noexcept -> std::size_t { return queues.size(); }
+
+		/// @brief Run every task, the calling thread being the first worker.
+		/// @param count Number of tasks, each dealt to a worker in contiguous runs so neighbouring chunks stay on one thread.
+		/// @param task Called as `task(worker, index)` once per index.
+		template<typename Task>
+		void run(const std::size_t count, Task&& task)
+		{
+			for (std::size_t worker {}; worker < queues.size(); ++worker)
+			{
+				for (auto index = count * worker / queues.size(); index < count * (worker + 1) / queues.size(); ++index)
+				{
+					queues[worker].tasks.push_back(index);
+				}
+			}
+
+			auto work = [&](const std::size_t worker)
+			{
+				while (const auto index = pop(worker))
+				{
+					task(worker, *index);
+				}
+			};
+
+			std::vector<std::jthread> threads {};
+
+			for (std::size_t worker {1}; worker < queues.size(); ++worker)
+			{
+				threads.emplace_back(work, worker);
+			}
+
+			work(0);
+		}
+	};
+
+	/// @brief Column storage of one worker, reused for every chunk it validates.
+	struct scratch
+	{
+		std::vector<std::string_view> rows;
+		std::vector<std::uint8_t> status;
+		std::vector<std::uint16_t> type_size;
+		std::vector<std::uint32_t> parameters;
+		std::vector<unsigned char> after_slash;
+		std::vector<unsigned char> after_first_dot;
+		std::vector<unsigned char> last_plus;
+
+		/// @brief Occurrences by interned identifier.
+		std::vector<std::uint64_t> counts;
+
+		/// @brief Types counted, in the order first seen.
+		std::vector<interned_media_type> types;
+
+		std::uint64_t invalid {};
+
+		[[nodiscard]] auto columns() -> media_type_columns
+		{
+			status.resize(rows.size());
+			type_size.resize(rows.size());
+			parameters.resize(rows.size());
+			after_slash.resize(rows.size());
+			after_first_dot.resize(rows.size());
+			last_plus.resize(rows.size());
+			return {status, type_size, parameters, after_slash, after_first_dot, last_plus};
+		}
+	};
+
+	/// @brief Validate chunk into the columns of worker, then intern and count every valid row.
+	void normalise(const std::string_view chunk, scratch& worker, media_type_registry& registry)
+	{
+		worker.rows.clear();
+
+		for (std::size_t first {}; first < chunk.size();)
+		{
+			auto last = chunk.find('\n', first);
+			last = last == std::string_view::npos ? chunk.size() : last;
+			auto row = chunk.substr(first, last - first);
+
+			if (row.ends_with('\r'))
+			{
+				row.remove_suffix(1);
+			}
+
+			if (not row.empty())
+			{
+				worker.rows.push_back(row);
+			}
+
+			first = last + 1;
+		}
+
+		const auto columns = worker.columns();
+		validate_batch(worker.rows, columns);
+
+		for (std::size_t row {}; row < worker.rows.size(); ++row)
+		{
+			if (columns.error(row))
+			{
+				++worker.invalid;
+				continue;
+			}
+
+			/* Only the type is interned, so types differing in parameters alone are counted together. */
+			const auto type = registry.intern(media_type_view {worker.rows[row].substr(0, columns.type_size[row])});
+
+			if (type.id() >= worker.counts.size())
+			{
+				worker.counts.resize(std::max<std::size_t>(type.id() + 1, worker.counts.size() * 2));
+			}
+
+			if (worker.counts[type.id()]++ == 0)
+			{
+				worker.types.push_back(type);
+			}
+		}
+	}
+
+	struct result
+	{
+		std::vector<std::pair<std::string, std::uint64_t>> counts;
+		std::uint64_t invalid {};
+	};
+
+	/// @brief Normalise the whole input with the given number of threads, into a registry of its own.
+	[[nodiscard]] auto normalise(const std::span<const std::string_view> chunks, const std::size_t threads) -> result
+	{
+		media_type_registry registry {};
+		work_stealing_pool pool {threads};
+		std::vector<scratch> workers(pool.workers());
+
+		pool.run(chunks.size(), [&](const std::size_t worker, const std::size_t index) { normalise(chunks[index], workers[worker], registry); });
+
+		std::vector<std::uint64_t> counts(registry.size());
+		std::vector<std::optional<interned_media_type>> types(registry.size());
+		result merged {};
+
+		for (const auto& worker : workers)
+		{
+			for (const auto type : worker.types)
+			{
+				counts[type.id()] += worker.counts[type.id()];
+				types[type.id()] = type;
+			}
+
+			merged.invalid += worker.invalid;
+		}
+
+		for (const auto& type : types)
+		{
+			if (type)
+			{
+				merged.counts.emplace_back(registry.view(*type).string(), counts[type->id()]);
+			}
+		}
+
+		/* Most frequent first, ties in canonical order so every thread count writes the same output. */
+		std::ranges::sort(merged.counts, [](const auto& left, const auto& right)
+		{ return left.second != right.second ? left.second > right.second : left.first < right.first; });
+
+		return merged;
+	}
+}
+
+auto main(const int argc, const char* const* const argv) -> int
+{
+	if (argc < 2 or argc > 3)
+	{
+		std::fputs("usage: common_good_normalise <file> [threads]\n"
+				   "Counts the canonical media types of a file holding one per line, written to standard output most frequent first.\n"
+				   "Reports throughput of every thread count from 1 to threads, all cores by default, to standard error.\n",
+				   stderr);
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		const mapped_file file {argv[1]};
+		const auto input = file.view();
+		const std::size_t threads = argc == 3 ? std::stoul(argv[2]) : std::max(std::thread::hardware_concurrency(), 1U);
+
+		if (threads == 0)
+		{
+			throw std::invalid_argument {"threads must be at least 1"};
+		}
+
+		/* Enough chunks for every worker to steal from, without making a chunk too small to amortise its columns. */
+		const auto chunks = chunk(input, std::clamp<std::size_t>(input.size() / (threads * 16), 4096, 1 << 20));
+
+		std::fputs(std::format("{} bytes, {} chunks\nthreads      seconds         MB/s  speedup\n", input.size(), chunks.size()).c_str(), stderr);
+
+		result last {};
+		double single {};
+
+		for (std::size_t count {1}; count <= threads; ++count)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			auto current = normalise(chunks, count);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			if (count == 1)
+			{
+				single = elapsed.count();
+			}
+			else if (current.counts != last.counts or current.invalid != last.invalid)
+			{
+				throw std::logic_error {std::format("{} threads counted differently from {}", count, count - 1)};
+			}
+
+			std::fputs(std::format("{:>7} {:>12.6f} {:>12.1f} {:>8.2f}\n", count, elapsed.count(),
+								   static_cast<double>(input.size()) / elapsed.count() / 1e6, single / elapsed.count())
+						   .c_str(),
+					   stderr);
+			last = std::move(current);
+		}
+
+		std::string output {};
+
+		for (const auto& [type, count] : last.counts)
+		{
+			std::format_to(std::back_inserter(output), "{} {}\n", count, type);
+		}
+
+		std::fwrite(output.data(), 1, output.size(), stdout);
+		std::fputs(std::format("{} invalid lines\n", last.invalid).c_str(), stderr);
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& error)
+	{
+		std::fputs(std::format("common_good_normalise: {}\n", error.what()).c_str(), stderr);
+		return EXIT_FAILURE;
+	}
+}